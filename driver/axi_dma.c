@@ -31,6 +31,14 @@ module_param(chrdev_name, charp, S_IRUGO);
 static int minor_num = MINOR_NUMBER;
 module_param(minor_num, int, S_IRUGO);
 
+/* The size in bytes of the DMA buffer pool to reserve at probe time. This is
+ * the fallback for when the device tree does not name a reserved-memory node
+ * through the 'memory-region' property; the pool is then allocated once at
+ * probe time, before runtime churn can fragment the CMA area. 0 (the
+ * default) disables the fallback pool. */
+static ulong pool_size = 0;
+module_param(pool_size, ulong, S_IRUGO);
+
 /*----------------------------------------------------------------------------
  * Platform Device Functions
  *----------------------------------------------------------------------------*/
@@ -47,6 +55,7 @@ static int axidma_probe(struct platform_device *pdev)
         return -ENOMEM;
     }
     axidma_dev->pdev = pdev;
+    axidma_dev->pool_fallback_size = pool_size;
 
     // Initialize the DMA interface
     rc = axidma_dma_init(pdev, axidma_dev);
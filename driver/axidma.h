@@ -14,7 +14,11 @@
 
 // Kernel dependencies
 #include <linux/list.h>         // Linked list definitions and functions
+#include <linux/atomic.h>           // Atomic reference count operations
+#include <linux/rbtree.h>           // Red-black tree definitions and functions
 #include <linux/kernel.h>           // Contains the definition for printk
+#include <linux/spinlock.h>         // Spinlock definitions and functions
+#include <linux/mutex.h>            // Mutex definitions and functions
 #include <linux/device.h>           // Definitions for class and device structs
 #include <linux/cdev.h>             // Definitions for character device structs
 #include <linux/signal.h>           // Definition of signal numbers
@@ -42,8 +46,70 @@
     printk(KERN_INFO MODULE_NAME ": %s: %s: %d: " fmt, __FILENAME__, __func__, \
             __LINE__, ## __VA_ARGS__)
 
-// Forward declaration of the callback data structure for DMA
-struct axidma_cb_data;
+// Forward declaration of the per-channel DMA transfer state
+struct axidma_chan_state;
+
+// Forward declaration of the kernel's carving allocator (genalloc)
+struct gen_pool;
+
+// The origin of a DMA memory region registered with the driver
+enum axidma_region_type {
+    AXIDMA_REGION_INTERNAL,         // Allocated by this driver through mmap
+    AXIDMA_REGION_EXTERNAL          // Allocated by another driver (dma-buf)
+};
+
+/* A region of memory usable for DMA transfers. This is embedded in both the
+ * internal and external allocation structures, and indexed by a red-black
+ * tree keyed on the user virtual address, so that the user virtual to DMA
+ * address translation on the transfer path is logarithmic in the number of
+ * registered buffers. */
+struct axidma_dma_region {
+    enum axidma_region_type type;   // The origin of the region
+    void *user_addr;                // User virtual address of the region
+    size_t size;                    // Size of the region in bytes
+    dma_addr_t dma_addr;            // DMA bus address of the region
+    struct rb_node node;            // Tree node pointers for the region index
+
+    /* The physical segments of a non-contiguous region. External buffers
+     * imported from other drivers are rarely physically contiguous; their
+     * segment list is carried here so transfers can walk it directly into
+     * the descriptor chain. Contiguous regions leave sg_len at zero, and
+     * are described entirely by dma_addr. */
+    struct scatterlist *sg_list;    // Segments of a non-contiguous region
+    int sg_len;                     // The number of segments (0 if contiguous)
+};
+
+// The maximum number of pre-resolved buffer handles that can be live at once
+#define AXIDMA_MAX_BUF_HANDLES      64
+
+/* An entry in the table of pre-resolved buffer handles. The DMA address is
+ * resolved when the handle is created, so transfers using the handle skip
+ * the address translation entirely. */
+struct axidma_buf_handle_entry {
+    struct axidma_dma_region *region;   // Region of the handle (NULL if free)
+    dma_addr_t dma_addr;                // Resolved DMA address of the handle
+    size_t size;                        // Bytes from the handle to region end
+};
+
+// The maximum number of transfer templates that can be live at once
+#define AXIDMA_MAX_TEMPLATES        16
+
+/* An entry in the table of pre-prepared transfer templates. The scatter-
+ * gather list describing the buffer is built when the template is created,
+ * and kept for its lifetime. On engines that support the descriptor reuse
+ * facility, the prepared descriptor itself is kept as well, so triggering
+ * the template skips descriptor preparation entirely. */
+struct axidma_template_entry {
+    struct axidma_chan *chan;       // Channel of the template (NULL if free)
+    struct scatterlist *sg_list;    // Pre-built scatter-gather list
+    int sg_len;                     // The number of entries in the list
+    size_t num_bytes;               // Total bytes moved by the template
+    struct dma_async_tx_descriptor *desc;   // Reusable descriptor (optional)
+    bool busy;                      // The reusable descriptor is in flight
+};
+
+// Forward declaration of the per-open-file client structure
+struct axidma_client;
 
 // All of the meta-data needed for an axidma device
 struct axidma_device {
@@ -62,10 +128,44 @@ struct axidma_device {
     int num_chans;                  // The total number of DMA channels
     int notify_signal;              // Signal used to notify transfer completion
     struct platform_device *pdev;   // The platofrm device from the device tree
-    struct axidma_cb_data *cb_data; // The callback data for each channel
+    struct axidma_chan_state *chan_states;  // Per-channel transfer state
     struct axidma_chan *channels;   // All available channels
-    struct list_head dmabuf_list;   // List of allocated DMA buffers
-    struct list_head external_dmabufs;  // Buffers allocated in other drivers
+    struct axidma_chan **chan_index;    // Channel lookup table, by channel id
+    struct axidma_client **chan_owners; // The claiming client per channel
+    spinlock_t owner_lock;          // Protects the channel owner array
+    struct mutex engine_lock;       // Serializes lazy engine acquisition
+    struct dentry *debugfs_dir;     // Debugfs directory for statistics
+
+    /* The boot-time reserved DMA pool. When a pool is configured, mmap
+     * allocations are carved out of it instead of going through on-demand
+     * coherent allocations, which is nearly instant and immune to CMA
+     * fragmentation. */
+    phys_addr_t pool_phys;          // Physical base address of the pool
+    size_t pool_size;               // Size of the pool in bytes (0 if none)
+    size_t pool_fallback_size;      // Module parameter fallback pool size
+    void *pool_virt;                // Kernel virtual base address of the pool
+    dma_addr_t pool_dma;            // DMA base address of the pool
+    bool pool_coherent;             // Pool came from dma_alloc_coherent
+    struct gen_pool *pool;          // Carving allocator over the pool
+};
+
+/* The per-open-file state for the device. The device supports concurrent
+ * opens, so that independent processes can each drive their own channels
+ * directly. Each open file carries its own namespace of DMA buffers and its
+ * own completion ring, and may claim channels for its exclusive use. The
+ * structure is reference counted, since the memory mappings it indexes can
+ * outlive the file itself. */
+struct axidma_client {
+    struct axidma_device *dev;      // The device the file was opened on
+    atomic_t refcount;              // References from the file and its VMAs
+    struct rb_root dmabuf_tree;     // Index of this file's DMA regions
+    struct axidma_dma_region *last_region;  // Most recently used region
+    struct axidma_buf_handle_entry buf_handles[AXIDMA_MAX_BUF_HANDLES];
+                                    // Table of pre-resolved buffer handles
+    struct axidma_template_entry templates[AXIDMA_MAX_TEMPLATES];
+                                    // Table of pre-prepared templates
+    struct axidma_cq_ring *cq_ring; // Shared completion ring page
+    spinlock_t cq_lock;             // Protects the completion ring producer
 };
 
 /*----------------------------------------------------------------------------
@@ -82,6 +182,8 @@ struct axidma_device {
 // Function prototypes
 int axidma_chrdev_init(struct axidma_device *dev);
 void axidma_chrdev_exit(struct axidma_device *dev);
+void axidma_cq_record(struct axidma_client *client, int channel_id,
+                      int cookie);
 
 /*----------------------------------------------------------------------------
  * DMA Device Definitions
@@ -98,19 +200,63 @@ void axidma_get_num_channels(struct axidma_device *dev,
                              struct axidma_num_channels *num_chans);
 void axidma_get_channel_info(struct axidma_device *dev,
                              struct axidma_channel_info *chan_info);
+int axidma_get_channel_stats(struct axidma_device *dev,
+                             struct axidma_chan_stats *stats);
+int axidma_get_transfer_times(struct axidma_device *dev,
+                              struct axidma_transfer_times *times);
 int axidma_set_signal(struct axidma_device *dev, int signal);
-int axidma_read_transfer(struct axidma_device *dev,
+int axidma_set_eventfd(struct axidma_client *client, struct axidma_eventfd *efd);
+int axidma_set_coalescing(struct axidma_device *dev,
+                          struct axidma_coalesce *coal);
+int axidma_claim_channel(struct axidma_client *client, int channel_id);
+void axidma_release_channels(struct axidma_client *client);
+int axidma_acquire_channel(struct axidma_client *client, int channel_id);
+int axidma_release_channel(struct axidma_client *client, int channel_id);
+int axidma_read_transfer(struct axidma_client *client,
                           struct axidma_transaction *trans);
-int axidma_write_transfer(struct axidma_device *dev,
+int axidma_write_transfer(struct axidma_client *client,
                           struct axidma_transaction *trans);
-int axidma_rw_transfer(struct axidma_device *dev,
+int axidma_user_transfer(struct axidma_client *client,
+                         struct axidma_transaction *trans,
+                         enum axidma_dir dir);
+int axidma_batch_transfer(struct axidma_client *client,
+                          struct axidma_batch_transaction *batch);
+int axidma_vec_transfer(struct axidma_client *client,
+                        struct axidma_transaction_vec *trans,
+                        enum axidma_dir dir);
+int axidma_rw_transfer(struct axidma_client *client,
                        struct axidma_inout_transaction *trans);
-int axidma_video_transfer(struct axidma_device *dev,
+int axidma_video_transfer(struct axidma_client *client,
                           struct axidma_video_transaction *trans,
                           enum axidma_dir dir);
-int axidma_stop_channel(struct axidma_device *dev, struct axidma_chan *chan);
-dma_addr_t axidma_uservirt_to_dma(struct axidma_device *dev, void *user_addr,
-                                  size_t size);
+int axidma_video_set_frame(struct axidma_client *client,
+                           struct axidma_frame_sel *sel);
+int axidma_stream_start(struct axidma_client *client,
+                        struct axidma_stream *stream);
+int axidma_stream_next(struct axidma_client *client,
+                       struct axidma_stream_slot *slot);
+int axidma_stream_stop(struct axidma_client *client, int channel_id);
+int axidma_cancel_transfer(struct axidma_client *client,
+                           struct axidma_cancel *cancel);
+int axidma_stop_channel(struct axidma_client *client,
+                        struct axidma_chan *chan);
+dma_addr_t axidma_uservirt_to_dma(struct axidma_client *client,
+                                  void *user_addr, size_t size);
+int axidma_uservirt_sg_count(struct axidma_client *client, void *user_addr,
+                             size_t size);
+int axidma_uservirt_to_sg(struct axidma_client *client, void *user_addr,
+                          size_t size, struct scatterlist *sg_list,
+                          int max_segs);
+int axidma_get_buffer_handle(struct axidma_client *client,
+                             struct axidma_buffer_handle *buf_handle);
+dma_addr_t axidma_handle_to_dma(struct axidma_client *client, int handle,
+                                size_t offset, size_t size);
+int axidma_create_template(struct axidma_client *client,
+                           struct axidma_template *tmpl);
+int axidma_trigger_transfer(struct axidma_client *client,
+                            struct axidma_trigger *trigger);
+int axidma_destroy_template(struct axidma_client *client, int template_id);
+void axidma_free_templates(struct axidma_client *client);
 
 /*----------------------------------------------------------------------------
  * Device Tree Definitions
@@ -124,5 +270,7 @@ dma_addr_t axidma_uservirt_to_dma(struct axidma_device *dev, void *user_addr,
 int axidma_of_num_channels(struct platform_device *pdev);
 int axidma_of_parse_dma_nodes(struct platform_device *pdev,
                               struct axidma_device *dev);
+int axidma_of_parse_reserved_mem(struct platform_device *pdev,
+                                 struct axidma_device *dev);
 
 #endif /* AXIDMA_H_ */
@@ -24,7 +24,12 @@
 #include <linux/of_device.h>    // Device tree device related functions
 
 #include <linux/dma-buf.h>      // DMA shared buffers interface
+#include <linux/dma-mapping.h>  // DMA mapping and synchronization functions
 #include <linux/scatterlist.h>  // Scatter-gather table definitions
+#include <linux/ktime.h>        // Monotonic kernel timestamps
+#include <linux/gfp.h>          // Page allocation functions
+#include <linux/genalloc.h>     // Carving allocator for the reserved pool
+#include <linux/io.h>           // Memory remapping functions
 
 // Local dependencies
 #include "axidma.h"             // Local definitions
@@ -37,29 +42,32 @@
 // TODO: Maybe this can be improved?
 static struct axidma_device *axidma_dev;
 
+/* The maximum number of array elements accepted from userspace for a single
+ * vectored or batched request. This bounds the kernel allocation, and keeps
+ * the element count from overflowing the allocation size computation. */
+#define AXIDMA_MAX_USER_ELEMS       1024
+
 // A structure that represents a DMA buffer allocation
 struct axidma_dma_allocation {
-    size_t size;                // Size of the buffer
-    void *user_addr;            // User virtual address of the buffer
-    void *kern_addr;            // Kernel virtual address of the buffer
-    dma_addr_t dma_addr;        // DMA bus address of the buffer
-    struct list_head list;      // List node pointers for allocation list
+    struct axidma_dma_region region;    // User address, size, and DMA address
+    void *kern_addr;                    // Kernel virtual address of the buffer
+    struct axidma_client *client;       // The client the buffer belongs to
+    bool cached;                        // Cached pages with a streaming mapping
+    bool from_pool;                     // Carved from the reserved DMA pool
 };
 
 /* A structure that represents a DMA buffer allocation imported from another
  * driver in the kernel, through the DMA buffer sharing interface. */
 struct axidma_external_allocation {
+    struct axidma_dma_region region;        // User address, size, DMA address
     int fd;                                 // File descritpor for buffer share
     struct dma_buf *dma_buf;                // Structure representing the buffer
     struct dma_buf_attachment *dma_attach;  // Structre represnting attachment
-    size_t size;                            // Total size of the buffer
-    void *user_addr;                        // Buffer's user virtual address
     struct sg_table *sg_table;              // DMA scatter-gather table
-    struct list_head list;                  // Node pointers for the list
 };
 
 /*----------------------------------------------------------------------------
- * VMA Operations
+ * DMA Region Index
  *----------------------------------------------------------------------------*/
 
 static bool valid_dma_request(void *dma_start, size_t dma_size, void *user_addr,
@@ -69,52 +77,313 @@ static bool valid_dma_request(void *dma_start, size_t dma_size, void *user_addr,
            (char *)user_addr + user_size <= (char *)dma_start + dma_size;
 }
 
+/* Inserts the given DMA region into the client's region index, which is a
+ * red-black tree keyed on the region's user virtual address. The regions in
+ * the tree never overlap, since they come from distinct user mappings. */
+static void axidma_region_insert(struct axidma_client *client,
+                                 struct axidma_dma_region *region)
+{
+    struct rb_node **link, *parent;
+    struct axidma_dma_region *entry;
+
+    // Descend to the leaf position where the new region belongs
+    link = &client->dmabuf_tree.rb_node;
+    parent = NULL;
+    while (*link != NULL) {
+        parent = *link;
+        entry = rb_entry(parent, struct axidma_dma_region, node);
+        if (region->user_addr < entry->user_addr) {
+            link = &parent->rb_left;
+        } else {
+            link = &parent->rb_right;
+        }
+    }
+
+    // Link the new region in, and rebalance the tree
+    rb_link_node(&region->node, parent, link);
+    rb_insert_color(&region->node, &client->dmabuf_tree);
+    return;
+}
+
+// Removes the given DMA region from the client's region index
+static void axidma_region_remove(struct axidma_client *client,
+                                 struct axidma_dma_region *region)
+{
+    int i;
+
+    rb_erase(&region->node, &client->dmabuf_tree);
+
+    // Make sure the cached lookup cannot return the removed region
+    if (client->last_region == region) {
+        client->last_region = NULL;
+    }
+
+    // Invalidate any buffer handles that resolve into the removed region
+    for (i = 0; i < AXIDMA_MAX_BUF_HANDLES; i++)
+    {
+        if (client->buf_handles[i].region == region) {
+            client->buf_handles[i].region = NULL;
+        }
+    }
+    return;
+}
+
+/* Finds the DMA region containing the given user virtual address range. If no
+ * such region is registered, then NULL is returned. The most recently used
+ * region is checked first, since transfers typically reuse the same buffer. */
+static struct axidma_dma_region *axidma_region_find(
+        struct axidma_client *client, void *user_addr, size_t size)
+{
+    struct rb_node *node;
+    struct axidma_dma_region *region;
+
+    // Check the cached region first, so repeated lookups skip the tree walk
+    region = client->last_region;
+    if (region != NULL &&
+        valid_dma_request(region->user_addr, region->size, user_addr, size)) {
+        return region;
+    }
+
+    /* Walk down the tree. Since the regions never overlap, the containing
+     * region, if any, is the one with the largest starting address that does
+     * not exceed the requested address. */
+    node = client->dmabuf_tree.rb_node;
+    while (node != NULL) {
+        region = rb_entry(node, struct axidma_dma_region, node);
+        if (user_addr < region->user_addr) {
+            node = node->rb_left;
+        } else if (valid_dma_request(region->user_addr, region->size,
+                                     user_addr, size)) {
+            client->last_region = region;
+            return region;
+        } else {
+            node = node->rb_right;
+        }
+    }
+
+    return NULL;
+}
+
 /* Converts the given user space virtual address to a DMA address. If the
- * conversion is unsuccessful, then (dma_addr_t)NULL is returned. */
-dma_addr_t axidma_uservirt_to_dma(struct axidma_device *dev, void *user_addr,
-                                  size_t size)
+ * conversion is unsuccessful, then (dma_addr_t)NULL is returned. For a
+ * non-contiguous region, the requested range must fit within one of the
+ * region's physical segments; ranges that span segments can only be used
+ * through the scatter-gather conversion below. */
+dma_addr_t axidma_uservirt_to_dma(struct axidma_client *client,
+                                  void *user_addr, size_t size)
 {
-    bool valid;
-    dma_addr_t offset;
-    struct list_head *iter;
-    struct axidma_dma_allocation *dma_alloc;
-    struct axidma_external_allocation *dma_ext_alloc;
+    int i;
+    size_t offset, seg_len;
+    struct scatterlist *sg;
+    struct axidma_dma_region *region;
+
+    // Find the region containing the requested address range, if any
+    region = axidma_region_find(client, user_addr, size);
+    if (region == NULL) {
+        return (dma_addr_t)NULL;
+    }
+    offset = (char *)user_addr - (char *)region->user_addr;
+
+    // Resolve within the single segment containing the range, if segmented
+    if (region->sg_len > 0) {
+        for_each_sg(region->sg_list, sg, region->sg_len, i)
+        {
+            seg_len = sg_dma_len(sg);
+            if (offset < seg_len) {
+                if (size > seg_len - offset) {
+                    return (dma_addr_t)NULL;
+                }
+                return sg_dma_address(sg) + offset;
+            }
+            offset -= seg_len;
+        }
+        return (dma_addr_t)NULL;
+    }
+
+    return region->dma_addr + (dma_addr_t)offset;
+}
+
+/* Counts the scatter-gather entries needed to describe the given user
+ * virtual address range. Contiguous regions always need exactly one entry;
+ * imported external buffers can span several physical segments. */
+int axidma_uservirt_sg_count(struct axidma_client *client, void *user_addr,
+                             size_t size)
+{
+    int i, count;
+    size_t offset, seg_len, remaining;
+    struct scatterlist *sg;
+    struct axidma_dma_region *region;
+
+    // Find the region containing the requested address range, if any
+    region = axidma_region_find(client, user_addr, size);
+    if (region == NULL) {
+        return -EFAULT;
+    }
+    if (region->sg_len == 0) {
+        return 1;
+    }
+
+    // Walk the segments, counting those that overlap the requested range
+    offset = (char *)user_addr - (char *)region->user_addr;
+    remaining = size;
+    count = 0;
+    for_each_sg(region->sg_list, sg, region->sg_len, i)
+    {
+        seg_len = sg_dma_len(sg);
+        if (offset >= seg_len) {
+            offset -= seg_len;
+            continue;
+        }
+        count += 1;
+        if (remaining <= seg_len - offset) {
+            return count;
+        }
+        remaining -= seg_len - offset;
+        offset = 0;
+    }
 
-    // First iterate over DMA buffers allocated by this driver
-    list_for_each(iter, &dev->dmabuf_list)
+    // The region's segments do not cover the requested range
+    return -EFAULT;
+}
+
+/* Fills the given scatter-gather list with the physical segments covering
+ * the given user virtual address range, clipping the first and last segments
+ * to the range. Returns the number of entries used, or a negative error if
+ * the range cannot be resolved or needs more than max_segs entries. */
+int axidma_uservirt_to_sg(struct axidma_client *client, void *user_addr,
+                          size_t size, struct scatterlist *sg_list,
+                          int max_segs)
+{
+    int i, count;
+    size_t offset, seg_len, chunk, remaining;
+    struct scatterlist *sg;
+    struct axidma_dma_region *region;
+
+    // Find the region containing the requested address range, if any
+    region = axidma_region_find(client, user_addr, size);
+    if (region == NULL) {
+        return -EFAULT;
+    }
+    offset = (char *)user_addr - (char *)region->user_addr;
+
+    // A contiguous region is described by a single entry
+    if (region->sg_len == 0) {
+        if (max_segs < 1) {
+            return -EINVAL;
+        }
+        sg_dma_address(&sg_list[0]) = region->dma_addr + offset;
+        sg_dma_len(&sg_list[0]) = size;
+        return 1;
+    }
+
+    // Emit one clipped entry per segment that overlaps the requested range
+    remaining = size;
+    count = 0;
+    for_each_sg(region->sg_list, sg, region->sg_len, i)
     {
-        dma_alloc = container_of(iter, struct axidma_dma_allocation, list);
-        valid = valid_dma_request(dma_alloc->user_addr, dma_alloc->size,
-                                  user_addr, size);
-        if (valid) {
-            offset = (dma_addr_t)(user_addr - dma_alloc->user_addr);
-            return dma_alloc->dma_addr + offset;
+        seg_len = sg_dma_len(sg);
+        if (offset >= seg_len) {
+            offset -= seg_len;
+            continue;
+        }
+        if (count == max_segs) {
+            return -EINVAL;
         }
+        chunk = min(seg_len - offset, remaining);
+        sg_dma_address(&sg_list[count]) = sg_dma_address(sg) + offset;
+        sg_dma_len(&sg_list[count]) = chunk;
+        count += 1;
+        remaining -= chunk;
+        if (remaining == 0) {
+            return count;
+        }
+        offset = 0;
+    }
+
+    // The region's segments do not cover the requested range
+    return -EFAULT;
+}
+
+/* Creates a pre-resolved handle for the buffer at the given user virtual
+ * address. The DMA address is resolved once here, so transfers that use the
+ * handle never touch the region index at all. */
+int axidma_get_buffer_handle(struct axidma_client *client,
+                             struct axidma_buffer_handle *buf_handle)
+{
+    int i;
+    size_t offset;
+    struct axidma_dma_region *region;
+    struct axidma_buf_handle_entry *entry;
+
+    // Find the region containing the given user address
+    region = axidma_region_find(client, buf_handle->user_addr, 0);
+    if (region == NULL) {
+        axidma_err("Requested handle address %p does not fall within a "
+                   "previously allocated DMA buffer.\n", buf_handle->user_addr);
+        return -EFAULT;
     }
 
-    // Otherwise, iterate over the DMA buffers allocated by other drivers
-    list_for_each(iter, &dev->external_dmabufs)
+    // Handles resolve to a single DMA address, so need a contiguous region
+    if (region->sg_len > 0) {
+        axidma_err("Buffer handles cannot be created for non-contiguous "
+                   "external buffers.\n");
+        return -EINVAL;
+    }
+
+    // Find a free slot in the handle table
+    for (i = 0; i < AXIDMA_MAX_BUF_HANDLES; i++)
     {
-        dma_ext_alloc = container_of(iter, struct axidma_external_allocation,
-                                     list);
-        valid = valid_dma_request(dma_ext_alloc->user_addr, dma_ext_alloc->size,
-                                  user_addr, size);
-        if (valid) {
-            offset = (dma_addr_t)(user_addr - dma_ext_alloc->user_addr);
-            return sg_dma_address(&dma_ext_alloc->sg_table->sgl[0]) + offset;
+        if (client->buf_handles[i].region == NULL) {
+            break;
         }
     }
+    if (i == AXIDMA_MAX_BUF_HANDLES) {
+        axidma_err("All %d buffer handles are in use.\n",
+                   AXIDMA_MAX_BUF_HANDLES);
+        return -ENOSPC;
+    }
+
+    // Resolve the DMA address for the handle up front
+    offset = (char *)buf_handle->user_addr - (char *)region->user_addr;
+    entry = &client->buf_handles[i];
+    entry->region = region;
+    entry->dma_addr = region->dma_addr + offset;
+    entry->size = region->size - offset;
+
+    // Handles are 1-based, so a zeroed transaction never names a handle
+    buf_handle->handle = i + 1;
+    return 0;
+}
+
+/* Converts the given buffer handle and byte offset to a DMA address. If the
+ * handle is not live, or the requested range does not fit within the handle's
+ * buffer, then (dma_addr_t)NULL is returned. */
+dma_addr_t axidma_handle_to_dma(struct axidma_client *client, int handle,
+                                size_t offset, size_t size)
+{
+    struct axidma_buf_handle_entry *entry;
+
+    // Verify the handle names a live table entry, and the range fits in it
+    if (handle < 1 || handle > AXIDMA_MAX_BUF_HANDLES) {
+        return (dma_addr_t)NULL;
+    }
+    entry = &client->buf_handles[handle - 1];
+    if (entry->region == NULL || offset + size > entry->size) {
+        return (dma_addr_t)NULL;
+    }
 
-    // No matching allocation was found
-    return (dma_addr_t)NULL;
+    return entry->dma_addr + offset;
 }
 
-static int axidma_get_external(struct axidma_device *dev,
+static int axidma_get_external(struct axidma_client *client,
                                struct axidma_register_buffer *ext_buf)
 {
     int rc;
+    struct axidma_device *dev;
     struct axidma_external_allocation *dma_alloc;
 
+    dev = client->dev;
+
     // Allocate a structure to store information about the external buffer
     dma_alloc = kmalloc(sizeof(*dma_alloc), GFP_KERNEL);
     if (dma_alloc == NULL) {
@@ -149,23 +418,26 @@ static int axidma_get_external(struct axidma_device *dev,
         goto detach_ext_dma;
     }
 
-    // The allocation is expected to be one contiguous memory region
-    if (dma_alloc->sg_table->nents != 1) {
-        axidma_err("External DMA allocations must a single contiguous region "
-                   "of physical memory.\n");
-        rc = -EINVAL;
-        goto unmap_ext_dma;
+    // Add ourselves to the client's index of DMA regions
+    dma_alloc->region.type = AXIDMA_REGION_EXTERNAL;
+    dma_alloc->region.size = ext_buf->size;
+    dma_alloc->region.user_addr = ext_buf->user_addr;
+    dma_alloc->region.dma_addr = sg_dma_address(&dma_alloc->sg_table->sgl[0]);
+
+    /* Buffers exported by other drivers are rarely physically contiguous.
+     * Carry the segment list in the region, so transfers can walk the
+     * segments directly into the DMA descriptor chain. */
+    if (dma_alloc->sg_table->nents > 1) {
+        dma_alloc->region.sg_list = dma_alloc->sg_table->sgl;
+        dma_alloc->region.sg_len = dma_alloc->sg_table->nents;
+    } else {
+        dma_alloc->region.sg_list = NULL;
+        dma_alloc->region.sg_len = 0;
     }
 
-    // Add ourselves the driver's list of external allocations
-    dma_alloc->size = ext_buf->size;
-    dma_alloc->user_addr = ext_buf->user_addr;
-    list_add(&dma_alloc->list, &dev->external_dmabufs);
+    axidma_region_insert(client, &dma_alloc->region);
     return 0;
 
-unmap_ext_dma:
-    dma_buf_unmap_attachment(dma_alloc->dma_attach, dma_alloc->sg_table,
-                             DMA_BIDIRECTIONAL);
 detach_ext_dma:
     dma_buf_detach(dma_alloc->dma_buf, dma_alloc->dma_attach);
 put_ext_dma:
@@ -175,49 +447,210 @@ free_ext_alloc:
     return rc;
 }
 
-static int axidma_put_external(struct axidma_device *dev, void *user_addr)
+/* Releases the given external allocation, unmapping and detaching from the
+ * shared buffer, and removing it from the client's region index. */
+static void axidma_free_external(struct axidma_client *client,
+                                 struct axidma_external_allocation *dma_alloc)
 {
-    void *end_user_addr;
-    struct list_head *iter;
+    // Unmap the buffer, and detach ourselves from it
+    dma_buf_unmap_attachment(dma_alloc->dma_attach, dma_alloc->sg_table,
+                             DMA_BIDIRECTIONAL);
+    dma_buf_detach(dma_alloc->dma_buf, dma_alloc->dma_attach);
+    dma_buf_put(dma_alloc->dma_buf);
+
+    // Remove the allocation from the region index, and free the structure
+    axidma_region_remove(client, &dma_alloc->region);
+    kfree(dma_alloc);
+    return;
+}
+
+static int axidma_put_external(struct axidma_client *client, void *user_addr)
+{
+    struct axidma_dma_region *region;
     struct axidma_external_allocation *dma_alloc;
 
-    // Find the allocation corresponding to the user address
-    list_for_each(iter, &dev->external_dmabufs)
-    {
-        dma_alloc = container_of(iter, struct axidma_external_allocation, list);
-        end_user_addr = (char *)dma_alloc->user_addr + dma_alloc->size;
-
-        if (dma_alloc->user_addr <= user_addr && user_addr <= end_user_addr) {
-            // Unmap the buffer, and detach ourselves from it
-            dma_buf_unmap_attachment(dma_alloc->dma_attach,
-                    dma_alloc->sg_table, DMA_BIDIRECTIONAL);
-            dma_buf_detach(dma_alloc->dma_buf, dma_alloc->dma_attach);
-            dma_buf_put(dma_alloc->dma_buf);
-
-            // Free the allocation structure
-            kfree(dma_alloc);
-            return 0;
-        }
+    // Find the external allocation corresponding to the user address
+    region = axidma_region_find(client, user_addr, 0);
+    if (region == NULL || region->type != AXIDMA_REGION_EXTERNAL) {
+        return -ENOENT;
+    }
+    dma_alloc = container_of(region, struct axidma_external_allocation, region);
+
+    axidma_free_external(client, dma_alloc);
+    return 0;
+}
+
+/* Synchronizes a range of a cached DMA buffer between the processor and the
+ * device. When for_cpu is set, ownership of the range is handed to the
+ * processor (after a receive); otherwise it is handed back to the device
+ * (before a transmit). Coherent and external buffers need no maintenance, so
+ * the call is a harmless no-op for them. */
+static int axidma_sync_buffer(struct axidma_client *client,
+                              struct axidma_sync *sync, bool for_cpu)
+{
+    dma_addr_t dma_addr;
+    struct device *dev;
+    struct axidma_dma_region *region;
+    struct axidma_dma_allocation *dma_alloc;
+
+    // Find the region containing the requested address range
+    region = axidma_region_find(client, sync->buf, sync->len);
+    if (region == NULL) {
+        axidma_err("Sync address %p, size %zu does not fall within a "
+                   "previously allocated DMA buffer.\n", sync->buf, sync->len);
+        return -EFAULT;
+    }
+
+    // Only cached internal allocations carry a streaming mapping to sync
+    if (region->type != AXIDMA_REGION_INTERNAL) {
+        return 0;
+    }
+    dma_alloc = container_of(region, struct axidma_dma_allocation, region);
+    if (!dma_alloc->cached) {
+        return 0;
+    }
+
+    // Perform the cache maintenance on just the requested range
+    dev = &client->dev->pdev->dev;
+    dma_addr = region->dma_addr +
+               ((char *)sync->buf - (char *)region->user_addr);
+    if (for_cpu) {
+        dma_sync_single_for_cpu(dev, dma_addr, sync->len, DMA_BIDIRECTIONAL);
+    } else {
+        dma_sync_single_for_device(dev, dma_addr, sync->len,
+                                   DMA_BIDIRECTIONAL);
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * Completion Ring
+ *----------------------------------------------------------------------------*/
+
+/* Appends a completion record to the shared completion ring, if user space
+ * has set one up. Records are published to user space with a release store to
+ * the ring's tail index. On overflow, the record is dropped and counted. */
+void axidma_cq_record(struct axidma_client *client, int channel_id, int cookie)
+{
+    struct axidma_cq_ring *ring;
+    struct axidma_cq_entry *entry;
+    unsigned long flags;
+    u32 head, tail;
+
+    ring = client->cq_ring;
+    if (ring == NULL) {
+        return;
+    }
+
+    /* Completion callbacks for different channels can run concurrently, so
+     * the producer side of the ring is serialized with a spinlock. */
+    spin_lock_irqsave(&client->cq_lock, flags);
+
+    head = smp_load_acquire(&ring->head);
+    tail = ring->tail;
+    if (tail - head >= ring->num_entries) {
+        ring->dropped += 1;
+        spin_unlock_irqrestore(&client->cq_lock, flags);
+        return;
+    }
+
+    // Fill in the completion record, then publish it to user space
+    entry = &ring->entries[tail % ring->num_entries];
+    entry->channel_id = channel_id;
+    entry->cookie = cookie;
+    entry->status = 0;
+    entry->timestamp = ktime_get_ns();
+    smp_store_release(&ring->tail, tail + 1);
+
+    spin_unlock_irqrestore(&client->cq_lock, flags);
+    return;
+}
+
+// The VMA operations for completion ring mappings (defined below)
+static const struct vm_operations_struct axidma_cq_vm_ops;
+
+// Maps the client's shared completion ring page into the calling process
+static int axidma_mmap_cq_ring(struct axidma_client *client,
+                               struct vm_area_struct *vma)
+{
+    size_t size;
+    int rc;
+
+    // The mapping must cover exactly the single ring page
+    size = vma->vm_end - vma->vm_start;
+    if (size != PAGE_SIZE) {
+        axidma_err("Completion ring mappings must be exactly one page.\n");
+        return -EINVAL;
+    }
+
+    rc = remap_pfn_range(vma, vma->vm_start,
+                         virt_to_phys(client->cq_ring) >> PAGE_SHIFT,
+                         PAGE_SIZE, vma->vm_page_prot);
+    if (rc < 0) {
+        axidma_err("Unable to map the completion ring into userspace.\n");
+        return rc;
+    }
+
+    /* The mapping can outlive the open file, so it holds its own reference
+     * to the client, keeping the ring page alive until it is unmapped. The
+     * mapping is not inherited across a fork, as the child would otherwise
+     * share the parent's ring without holding a reference. */
+    vma->vm_ops = &axidma_cq_vm_ops;
+    vma->vm_private_data = client;
+    vma->vm_flags |= VM_DONTCOPY;
+    atomic_inc(&client->refcount);
+    return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * Client Lifetime
+ *----------------------------------------------------------------------------*/
+
+/* Drops a reference to the given client, freeing it when the last reference
+ * is gone. References are held by the open file itself, and by each DMA
+ * buffer mapping, which can outlive the file. */
+static void axidma_client_put(struct axidma_client *client)
+{
+    if (!atomic_dec_and_test(&client->refcount)) {
+        return;
     }
 
-    return -ENOENT;
+    free_page((unsigned long)client->cq_ring);
+    kfree(client);
+    return;
 }
 
+/*----------------------------------------------------------------------------
+ * VMA Operations
+ *----------------------------------------------------------------------------*/
+
 static void axidma_vma_close(struct vm_area_struct *vma)
 {
-    struct axidma_device *dev;
+    struct axidma_client *client;
     struct axidma_dma_allocation *dma_alloc;
 
     // Get the AXI DMA allocation data and free the DMA buffer
-    dev = axidma_dev;
     dma_alloc = vma->vm_private_data;
-    dma_free_coherent(&dev->pdev->dev, dma_alloc->size, dma_alloc->kern_addr,
-                      dma_alloc->dma_addr);
+    client = dma_alloc->client;
+    if (dma_alloc->cached) {
+        dma_unmap_single(&client->dev->pdev->dev, dma_alloc->region.dma_addr,
+                         dma_alloc->region.size, DMA_BIDIRECTIONAL);
+        free_pages((unsigned long)dma_alloc->kern_addr,
+                   get_order(dma_alloc->region.size));
+    } else if (dma_alloc->from_pool) {
+        gen_pool_free(client->dev->pool, (unsigned long)dma_alloc->kern_addr,
+                      dma_alloc->region.size);
+    } else {
+        dma_free_coherent(&client->dev->pdev->dev, dma_alloc->region.size,
+                          dma_alloc->kern_addr, dma_alloc->region.dma_addr);
+    }
 
-    // Remove the allocation from the list, and free the structure
-    list_del(&dma_alloc->list);
+    // Remove the allocation from the region index, and free the structure
+    axidma_region_remove(client, &dma_alloc->region);
     kfree(dma_alloc);
 
+    // Drop the mapping's reference to the client
+    axidma_client_put(client);
     return;
 }
 
@@ -226,29 +659,90 @@ static const struct vm_operations_struct axidma_vm_ops = {
     .close = axidma_vma_close,
 };
 
+// Drops the completion ring mapping's reference to the client
+static void axidma_cq_vma_close(struct vm_area_struct *vma)
+{
+    axidma_client_put(vma->vm_private_data);
+    return;
+}
+
+// The VMA operations for completion ring mappings
+static const struct vm_operations_struct axidma_cq_vm_ops = {
+    .close = axidma_cq_vma_close,
+};
+
 /*----------------------------------------------------------------------------
  * File Operations
  *----------------------------------------------------------------------------*/
 
 static int axidma_open(struct inode *inode, struct file *file)
 {
-    // Only the root user can open this device, and it must be exclusive
+    struct axidma_client *client;
+
+    // Only the root user can open this device
     if (!capable(CAP_SYS_ADMIN)) {
         axidma_err("Only root can open this device.");
         return -EACCES;
-    } else if (!(file->f_flags & O_EXCL)) {
-        axidma_err("O_EXCL must be specified for open()\n");
-        return -EINVAL;
     }
 
-    // Place the axidma structure in the private data of the file
-    file->private_data = (void *)axidma_dev;
+    /* Allocate the per-open-file client structure. The device supports
+     * concurrent opens, each with its own namespace of DMA buffers. */
+    client = kzalloc(sizeof(*client), GFP_KERNEL);
+    if (client == NULL) {
+        axidma_err("Unable to allocate the client structure.\n");
+        return -ENOMEM;
+    }
+    client->dev = axidma_dev;
+    atomic_set(&client->refcount, 1);
+    client->dmabuf_tree = RB_ROOT;
+
+    /* Allocate the page for the client's shared completion ring. The ring
+     * only becomes active once user space maps it at the magic ring offset. */
+    spin_lock_init(&client->cq_lock);
+    client->cq_ring = (struct axidma_cq_ring *)get_zeroed_page(GFP_KERNEL);
+    if (client->cq_ring == NULL) {
+        axidma_err("Unable to allocate the completion ring page.\n");
+        kfree(client);
+        return -ENOMEM;
+    }
+    client->cq_ring->num_entries = AXIDMA_CQ_NUM_ENTRIES;
+
+    // Place the client structure in the private data of the file
+    file->private_data = (void *)client;
     return 0;
 }
 
 static int axidma_release(struct inode *inode, struct file *file)
 {
+    struct rb_node *node;
+    struct axidma_client *client;
+    struct axidma_dma_region *region;
+    struct axidma_external_allocation *dma_alloc;
+
+    client = file->private_data;
+
+    // Give back any channels this file claimed for its exclusive use
+    axidma_release_channels(client);
+
+    // Destroy any transfer templates the user did not destroy
+    axidma_free_templates(client);
+
+    /* Release any external buffers the user did not unregister. The internal
+     * allocations are torn down by their memory mappings, which hold their
+     * own references to the client. */
+    node = rb_first(&client->dmabuf_tree);
+    while (node != NULL) {
+        region = rb_entry(node, struct axidma_dma_region, node);
+        node = rb_next(node);
+        if (region->type == AXIDMA_REGION_EXTERNAL) {
+            dma_alloc = container_of(region,
+                    struct axidma_external_allocation, region);
+            axidma_free_external(client, dma_alloc);
+        }
+    }
+
     file->private_data = NULL;
+    axidma_client_put(client);
     return 0;
 }
 
@@ -256,10 +750,17 @@ static int axidma_mmap(struct file *file, struct vm_area_struct *vma)
 {
     int rc;
     struct axidma_device *dev;
+    struct axidma_client *client;
     struct axidma_dma_allocation *dma_alloc;
 
-    // Get the axidma device structure
-    dev = file->private_data;
+    // Get the client and axidma device structures
+    client = file->private_data;
+    dev = client->dev;
+
+    // The magic ring offset maps the completion ring instead of a DMA buffer
+    if (vma->vm_pgoff == (AXIDMA_CQ_RING_OFFSET >> PAGE_SHIFT)) {
+        return axidma_mmap_cq_ring(client, vma);
+    }
 
     // Allocate a structure to store data about the DMA mapping
     dma_alloc = kmalloc(sizeof(*dma_alloc), GFP_KERNEL);
@@ -270,32 +771,105 @@ static int axidma_mmap(struct file *file, struct vm_area_struct *vma)
     }
 
     // Set the user virtual address and the size
-    dma_alloc->size = vma->vm_end - vma->vm_start;
-    dma_alloc->user_addr = (void *)vma->vm_start;
+    dma_alloc->region.type = AXIDMA_REGION_INTERNAL;
+    dma_alloc->region.size = vma->vm_end - vma->vm_start;
+    dma_alloc->region.user_addr = (void *)vma->vm_start;
+    dma_alloc->region.sg_list = NULL;
+    dma_alloc->region.sg_len = 0;
+    dma_alloc->client = client;
+
+    /* The magic cached offset requests ordinary cached pages with a streaming
+     * DMA mapping, instead of uncached coherent memory. */
+    dma_alloc->cached =
+            (vma->vm_pgoff == (AXIDMA_CACHED_BUF_OFFSET >> PAGE_SHIFT));
+    dma_alloc->from_pool = false;
 
     // Configure the DMA device
     of_dma_configure(dev->device, NULL);
 
-    // Allocate the requested region a contiguous and uncached for DMA
-    dma_alloc->kern_addr = dma_alloc_coherent(&dev->pdev->dev, dma_alloc->size,
-                                              &dma_alloc->dma_addr, GFP_KERNEL);
-    if (dma_alloc->kern_addr == NULL) {
-        axidma_err("Unable to allocate contiguous DMA memory region of size "
-                   "%zu.\n", dma_alloc->size);
-        axidma_err("Please make sure that you specified cma=<size> on the "
-                   "kernel command line, and the size is large enough.\n");
-        rc = -ENOMEM;
-        goto free_vma_data;
-    }
+    if (dma_alloc->cached) {
+        /* Allocate cached pages for the buffer, so CPU-side processing of
+         * the data runs at full speed, and give them a streaming DMA
+         * mapping. The user pays a targeted cache flush through the
+         * AXIDMA_SYNC_FOR_* ioctls around each transfer instead. */
+        dma_alloc->kern_addr = (void *)__get_free_pages(GFP_KERNEL,
+                get_order(dma_alloc->region.size));
+        if (dma_alloc->kern_addr == NULL) {
+            axidma_err("Unable to allocate cached DMA memory region of size "
+                       "%zu.\n", dma_alloc->region.size);
+            rc = -ENOMEM;
+            goto free_vma_data;
+        }
+        dma_alloc->region.dma_addr = dma_map_single(&dev->pdev->dev,
+                dma_alloc->kern_addr, dma_alloc->region.size,
+                DMA_BIDIRECTIONAL);
+        if (dma_mapping_error(&dev->pdev->dev, dma_alloc->region.dma_addr)) {
+            axidma_err("Unable to map the cached DMA memory region for "
+                       "streaming DMA.\n");
+            free_pages((unsigned long)dma_alloc->kern_addr,
+                       get_order(dma_alloc->region.size));
+            rc = -ENOMEM;
+            goto free_vma_data;
+        }
 
-    // Map the region into userspace
-    rc = dma_mmap_coherent(&dev->pdev->dev, vma, dma_alloc->kern_addr,
-                           dma_alloc->dma_addr, dma_alloc->size);
-    if (rc < 0) {
-        axidma_err("Unable to remap address %p to userspace address %p, size "
-                   "%zu.\n", dma_alloc->kern_addr, dma_alloc->user_addr,
-                   dma_alloc->size);
-        goto free_dma_region;
+        /* Map the region into userspace with the default (cacheable)
+         * protection. The magic offset is not a real file offset, so clear
+         * it before setting up the mapping. */
+        vma->vm_pgoff = 0;
+        rc = remap_pfn_range(vma, vma->vm_start,
+                virt_to_phys(dma_alloc->kern_addr) >> PAGE_SHIFT,
+                dma_alloc->region.size, vma->vm_page_prot);
+        if (rc < 0) {
+            axidma_err("Unable to remap address %p to userspace address %p, "
+                       "size %zu.\n", dma_alloc->kern_addr,
+                       dma_alloc->region.user_addr, dma_alloc->region.size);
+            goto free_dma_region;
+        }
+    } else {
+        /* Carve the buffer out of the reserved DMA pool when one is
+         * configured. This takes microseconds regardless of the buffer's
+         * size, and cannot fail from CMA fragmentation. When the pool is
+         * absent or exhausted, fall back on an on-demand allocation. */
+        if (dev->pool != NULL) {
+            dma_alloc->kern_addr = gen_pool_dma_alloc(dev->pool,
+                    dma_alloc->region.size, &dma_alloc->region.dma_addr);
+            dma_alloc->from_pool = (dma_alloc->kern_addr != NULL);
+        }
+        if (!dma_alloc->from_pool) {
+            // Allocate the requested region a contiguous and uncached for DMA
+            dma_alloc->kern_addr = dma_alloc_coherent(&dev->pdev->dev,
+                    dma_alloc->region.size, &dma_alloc->region.dma_addr,
+                    GFP_KERNEL);
+            if (dma_alloc->kern_addr == NULL) {
+                axidma_err("Unable to allocate contiguous DMA memory region "
+                           "of size %zu.\n", dma_alloc->region.size);
+                axidma_err("Please make sure that you specified cma=<size> on "
+                           "the kernel command line, and the size is large "
+                           "enough.\n");
+                rc = -ENOMEM;
+                goto free_vma_data;
+            }
+        }
+
+        // Map the region into userspace
+        if (dma_alloc->from_pool) {
+            /* Pool carvings are mapped by hand, with the uncached protection
+             * that matches a coherent allocation's semantics. */
+            vma->vm_page_prot = pgprot_noncached(vma->vm_page_prot);
+            rc = remap_pfn_range(vma, vma->vm_start,
+                    (unsigned long)(dma_alloc->region.dma_addr >> PAGE_SHIFT),
+                    dma_alloc->region.size, vma->vm_page_prot);
+        } else {
+            rc = dma_mmap_coherent(&dev->pdev->dev, vma, dma_alloc->kern_addr,
+                                   dma_alloc->region.dma_addr,
+                                   dma_alloc->region.size);
+        }
+        if (rc < 0) {
+            axidma_err("Unable to remap address %p to userspace address %p, "
+                       "size %zu.\n", dma_alloc->kern_addr,
+                       dma_alloc->region.user_addr, dma_alloc->region.size);
+            goto free_dma_region;
+        }
     }
 
     /* Override the VMA close with our call, so that we can free the DMA region
@@ -308,13 +882,25 @@ static int axidma_mmap(struct file *file, struct vm_area_struct *vma)
      * referring to the DMA buffer. */
     vma->vm_flags |= VM_DONTCOPY;
 
-    // Add the allocation to the driver's list of DMA buffers
-    list_add(&dma_alloc->list, &dev->dmabuf_list);
+    /* Add the allocation to the client's index of DMA regions. The mapping
+     * holds a reference to the client, since it can outlive the file. */
+    atomic_inc(&client->refcount);
+    axidma_region_insert(client, &dma_alloc->region);
     return 0;
 
 free_dma_region:
-    dma_free_coherent(&dev->pdev->dev, dma_alloc->size, dma_alloc->kern_addr,
-                      dma_alloc->dma_addr);
+    if (dma_alloc->cached) {
+        dma_unmap_single(&dev->pdev->dev, dma_alloc->region.dma_addr,
+                         dma_alloc->region.size, DMA_BIDIRECTIONAL);
+        free_pages((unsigned long)dma_alloc->kern_addr,
+                   get_order(dma_alloc->region.size));
+    } else if (dma_alloc->from_pool) {
+        gen_pool_free(dev->pool, (unsigned long)dma_alloc->kern_addr,
+                      dma_alloc->region.size);
+    } else {
+        dma_free_coherent(&dev->pdev->dev, dma_alloc->region.size,
+                          dma_alloc->kern_addr, dma_alloc->region.dma_addr);
+    }
 free_vma_data:
     kfree(dma_alloc);
 ret:
@@ -345,13 +931,30 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
     size_t size;
     void *__user arg_ptr;
     struct axidma_device *dev;
+    struct axidma_client *client;
     struct axidma_num_channels num_chans;
     struct axidma_channel_info usr_chans, kern_chans;
     struct axidma_register_buffer ext_buf;
+    struct axidma_buffer_handle buf_handle;
+    struct axidma_eventfd efd;
     struct axidma_transaction trans;
+    struct axidma_transaction_vec vec_trans;
+    struct axidma_iovec *__user user_iov;
+    struct axidma_batch_transaction batch_trans;
+    struct axidma_transaction *__user user_trans;
     struct axidma_inout_transaction inout_trans;
     struct axidma_video_transaction video_trans, *__user user_video_trans;
     struct axidma_chan chan_info;
+    struct axidma_stream stream;
+    struct axidma_stream_slot stream_slot;
+    struct axidma_chan_stats chan_stats;
+    struct axidma_transfer_times transfer_times;
+    struct axidma_template tmpl;
+    struct axidma_trigger trigger;
+    struct axidma_coalesce coal;
+    struct axidma_sync sync;
+    struct axidma_cancel cancel;
+    struct axidma_frame_sel frame_sel;
 
     // Coerce the arguement as a userspace pointer
     arg_ptr = (void __user *)arg;
@@ -376,8 +979,9 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
         }
     }
 
-    // Get the axidma device from the file
-    dev = file->private_data;
+    // Get the client and axidma device from the file
+    client = file->private_data;
+    dev = client->dev;
 
     // Perform the specified command
     switch (cmd) {
@@ -415,13 +1019,22 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
             rc = axidma_set_signal(dev, arg);
             break;
 
+        case AXIDMA_SET_DMA_EVENTFD:
+            if (copy_from_user(&efd, arg_ptr, sizeof(efd)) != 0) {
+                axidma_err("Unable to copy eventfd info from userspace for "
+                           "AXIDMA_SET_DMA_EVENTFD.\n");
+                return -EFAULT;
+            }
+            rc = axidma_set_eventfd(client, &efd);
+            break;
+
         case AXIDMA_REGISTER_BUFFER:
             if (copy_from_user(&ext_buf, arg_ptr, sizeof(ext_buf)) != 0) {
                 axidma_err("Unable to copy external buffer info from userspace "
                            "for AXIDMA_REGISTER_BUFFER.\n");
                 return -EFAULT;
             }
-            rc = axidma_get_external(dev, &ext_buf);
+            rc = axidma_get_external(client, &ext_buf);
             break;
 
         case AXIDMA_DMA_READ:
@@ -430,7 +1043,17 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
                            "AXIDMA_DMA_READ.\n");
                 return -EFAULT;
             }
-            rc = axidma_read_transfer(dev, &trans);
+            rc = axidma_read_transfer(client, &trans);
+            if (rc < 0) {
+                break;
+            }
+
+            // Report the assigned transfer id back to userspace
+            if (copy_to_user(arg_ptr, &trans, sizeof(trans)) != 0) {
+                axidma_err("Unable to copy transfer info to userspace for "
+                           "AXIDMA_DMA_READ.\n");
+                return -EFAULT;
+            }
             break;
 
         case AXIDMA_DMA_WRITE:
@@ -439,7 +1062,127 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
                            "AXIDMA_DMA_WRITE.\n");
                 return -EFAULT;
             }
-            rc = axidma_write_transfer(dev, &trans);
+            rc = axidma_write_transfer(client, &trans);
+            if (rc < 0) {
+                break;
+            }
+
+            // Report the assigned transfer id back to userspace
+            if (copy_to_user(arg_ptr, &trans, sizeof(trans)) != 0) {
+                axidma_err("Unable to copy transfer info to userspace for "
+                           "AXIDMA_DMA_WRITE.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_DMA_READ_USER:
+        case AXIDMA_DMA_WRITE_USER:
+            if (copy_from_user(&trans, arg_ptr, sizeof(trans)) != 0) {
+                axidma_err("Unable to copy transfer info from userspace for "
+                           "AXIDMA_DMA_READ_USER/AXIDMA_DMA_WRITE_USER.\n");
+                return -EFAULT;
+            }
+            rc = axidma_user_transfer(client, &trans,
+                    (cmd == AXIDMA_DMA_READ_USER) ? AXIDMA_READ
+                                                  : AXIDMA_WRITE);
+            if (rc < 0) {
+                break;
+            }
+
+            // Report the assigned transfer id back to userspace
+            if (copy_to_user(arg_ptr, &trans, sizeof(trans)) != 0) {
+                axidma_err("Unable to copy transfer info to userspace for "
+                           "AXIDMA_DMA_READ_USER/AXIDMA_DMA_WRITE_USER.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_DMA_READV:
+        case AXIDMA_DMA_WRITEV:
+            if (copy_from_user(&vec_trans, arg_ptr, sizeof(vec_trans)) != 0) {
+                axidma_err("Unable to copy transfer info from userspace for "
+                           "AXIDMA_DMA_READV/AXIDMA_DMA_WRITEV.\n");
+                return -EFAULT;
+            }
+
+            // Bound the segment count before sizing the kernel allocation
+            if (vec_trans.icount < 1 ||
+                vec_trans.icount > AXIDMA_MAX_USER_ELEMS) {
+                axidma_err("Invalid segment count %d for "
+                           "AXIDMA_DMA_READV/AXIDMA_DMA_WRITEV.\n",
+                           vec_trans.icount);
+                return -EINVAL;
+            }
+
+            // Allocate a kernel-space array for the transfer segments
+            user_iov = (struct axidma_iovec *__user)vec_trans.iov;
+            size = vec_trans.icount * sizeof(vec_trans.iov[0]);
+            vec_trans.iov = kmalloc_array(vec_trans.icount,
+                                          sizeof(vec_trans.iov[0]),
+                                          GFP_KERNEL);
+            if (vec_trans.iov == NULL) {
+                axidma_err("Unable to allocate array for the segments.\n");
+                return -ENOMEM;
+            }
+
+            // Copy the segment array from user space to kernel space
+            if (copy_from_user(vec_trans.iov, user_iov, size) != 0) {
+                axidma_err("Unable to copy the segment array from userspace "
+                           "for AXIDMA_DMA_READV/AXIDMA_DMA_WRITEV.\n");
+                kfree(vec_trans.iov);
+                return -EFAULT;
+            }
+
+            rc = axidma_vec_transfer(client, &vec_trans,
+                    (cmd == AXIDMA_DMA_READV) ? AXIDMA_READ : AXIDMA_WRITE);
+            kfree(vec_trans.iov);
+            break;
+
+        case AXIDMA_DMA_SUBMIT_BATCH:
+            if (copy_from_user(&batch_trans, arg_ptr,
+                               sizeof(batch_trans)) != 0) {
+                axidma_err("Unable to copy batch info from userspace for "
+                           "AXIDMA_DMA_SUBMIT_BATCH.\n");
+                return -EFAULT;
+            }
+
+            // Bound the transaction count before sizing the allocation
+            if (batch_trans.num_trans < 1 ||
+                batch_trans.num_trans > AXIDMA_MAX_USER_ELEMS) {
+                axidma_err("Invalid transaction count %d for "
+                           "AXIDMA_DMA_SUBMIT_BATCH.\n",
+                           batch_trans.num_trans);
+                return -EINVAL;
+            }
+
+            // Allocate a kernel-space array for the transactions
+            user_trans = (struct axidma_transaction *__user)batch_trans.trans;
+            size = batch_trans.num_trans * sizeof(batch_trans.trans[0]);
+            batch_trans.trans = kmalloc_array(batch_trans.num_trans,
+                                              sizeof(batch_trans.trans[0]),
+                                              GFP_KERNEL);
+            if (batch_trans.trans == NULL) {
+                axidma_err("Unable to allocate array for the "
+                           "transactions.\n");
+                return -ENOMEM;
+            }
+
+            // Copy the transaction array from user space to kernel space
+            if (copy_from_user(batch_trans.trans, user_trans, size) != 0) {
+                axidma_err("Unable to copy the transaction array from "
+                           "userspace for AXIDMA_DMA_SUBMIT_BATCH.\n");
+                kfree(batch_trans.trans);
+                return -EFAULT;
+            }
+
+            rc = axidma_batch_transfer(client, &batch_trans);
+            if (rc == 0 &&
+                copy_to_user(user_trans, batch_trans.trans, size) != 0) {
+                axidma_err("Unable to copy the transfer ids to userspace for "
+                           "AXIDMA_DMA_SUBMIT_BATCH.\n");
+                rc = -EFAULT;
+            }
+            kfree(batch_trans.trans);
             break;
 
         case AXIDMA_DMA_READWRITE:
@@ -449,7 +1192,7 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
                            "AXIDMA_DMA_READWRITE.\n");
                 return -EFAULT;
             }
-            rc = axidma_rw_transfer(dev, &inout_trans);
+            rc = axidma_rw_transfer(client, &inout_trans);
             break;
 
         case AXIDMA_DMA_VIDEO_READ:
@@ -479,7 +1222,7 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
                 return -EFAULT;
             }
 
-            rc = axidma_video_transfer(dev, &video_trans, AXIDMA_READ);
+            rc = axidma_video_transfer(client, &video_trans, AXIDMA_READ);
             kfree(video_trans.frame_buffers);
             break;
 
@@ -510,7 +1253,7 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
                 return -EFAULT;
             }
 
-            rc = axidma_video_transfer(dev, &video_trans, AXIDMA_WRITE);
+            rc = axidma_video_transfer(client, &video_trans, AXIDMA_WRITE);
             kfree(video_trans.frame_buffers);
             break;
 
@@ -519,11 +1262,200 @@ static long axidma_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
                 axidma_err("Unable to channel info from userspace for "
                            "AXIDMA_STOP_DMA_CHANNEL.\n");
             }
-            rc = axidma_stop_channel(dev, &chan_info);
+            rc = axidma_stop_channel(client, &chan_info);
             break;
 
         case AXIDMA_UNREGISTER_BUFFER:
-            rc = axidma_put_external(dev, (void *)arg);
+            rc = axidma_put_external(client, (void *)arg);
+            break;
+
+        case AXIDMA_CLAIM_CHANNEL:
+            rc = axidma_claim_channel(client, arg);
+            break;
+
+        case AXIDMA_ACQUIRE_CHANNEL:
+            rc = axidma_acquire_channel(client, arg);
+            break;
+
+        case AXIDMA_RELEASE_CHANNEL:
+            rc = axidma_release_channel(client, arg);
+            break;
+
+        case AXIDMA_STREAM_START:
+            if (copy_from_user(&stream, arg_ptr, sizeof(stream)) != 0) {
+                axidma_err("Unable to copy stream info from userspace for "
+                           "AXIDMA_STREAM_START.\n");
+                return -EFAULT;
+            }
+            rc = axidma_stream_start(client, &stream);
+            break;
+
+        case AXIDMA_STREAM_NEXT:
+            if (copy_from_user(&stream_slot, arg_ptr,
+                               sizeof(stream_slot)) != 0) {
+                axidma_err("Unable to copy slot info from userspace for "
+                           "AXIDMA_STREAM_NEXT.\n");
+                return -EFAULT;
+            }
+
+            rc = axidma_stream_next(client, &stream_slot);
+            if (rc < 0) {
+                break;
+            }
+
+            // Report the consumed slot back to userspace
+            if (copy_to_user(arg_ptr, &stream_slot,
+                             sizeof(stream_slot)) != 0) {
+                axidma_err("Unable to copy slot info to userspace for "
+                           "AXIDMA_STREAM_NEXT.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_STREAM_STOP:
+            rc = axidma_stream_stop(client, arg);
+            break;
+
+        case AXIDMA_SET_COALESCING:
+            if (copy_from_user(&coal, arg_ptr, sizeof(coal)) != 0) {
+                axidma_err("Unable to copy coalescing info from userspace "
+                           "for AXIDMA_SET_COALESCING.\n");
+                return -EFAULT;
+            }
+            rc = axidma_set_coalescing(dev, &coal);
+            break;
+
+        case AXIDMA_GET_CHANNEL_STATS:
+            if (copy_from_user(&chan_stats, arg_ptr,
+                               sizeof(chan_stats)) != 0) {
+                axidma_err("Unable to copy stats info from userspace for "
+                           "AXIDMA_GET_CHANNEL_STATS.\n");
+                return -EFAULT;
+            }
+
+            rc = axidma_get_channel_stats(dev, &chan_stats);
+            if (rc < 0) {
+                break;
+            }
+
+            if (copy_to_user(arg_ptr, &chan_stats,
+                             sizeof(chan_stats)) != 0) {
+                axidma_err("Unable to copy channel stats to userspace for "
+                           "AXIDMA_GET_CHANNEL_STATS.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_GET_TRANSFER_TIMES:
+            if (copy_from_user(&transfer_times, arg_ptr,
+                               sizeof(transfer_times)) != 0) {
+                axidma_err("Unable to copy times info from userspace for "
+                           "AXIDMA_GET_TRANSFER_TIMES.\n");
+                return -EFAULT;
+            }
+
+            rc = axidma_get_transfer_times(dev, &transfer_times);
+            if (rc < 0) {
+                break;
+            }
+
+            if (copy_to_user(arg_ptr, &transfer_times,
+                             sizeof(transfer_times)) != 0) {
+                axidma_err("Unable to copy transfer times to userspace for "
+                           "AXIDMA_GET_TRANSFER_TIMES.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_CREATE_TEMPLATE:
+            if (copy_from_user(&tmpl, arg_ptr, sizeof(tmpl)) != 0) {
+                axidma_err("Unable to copy template info from userspace for "
+                           "AXIDMA_CREATE_TEMPLATE.\n");
+                return -EFAULT;
+            }
+
+            rc = axidma_create_template(client, &tmpl);
+            if (rc < 0) {
+                break;
+            }
+
+            if (copy_to_user(arg_ptr, &tmpl, sizeof(tmpl)) != 0) {
+                axidma_err("Unable to copy the template id to userspace for "
+                           "AXIDMA_CREATE_TEMPLATE.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_DMA_TRIGGER:
+            if (copy_from_user(&trigger, arg_ptr, sizeof(trigger)) != 0) {
+                axidma_err("Unable to copy trigger info from userspace for "
+                           "AXIDMA_DMA_TRIGGER.\n");
+                return -EFAULT;
+            }
+
+            rc = axidma_trigger_transfer(client, &trigger);
+            if (rc < 0) {
+                break;
+            }
+
+            if (copy_to_user(arg_ptr, &trigger, sizeof(trigger)) != 0) {
+                axidma_err("Unable to copy the transfer id to userspace for "
+                           "AXIDMA_DMA_TRIGGER.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_DESTROY_TEMPLATE:
+            rc = axidma_destroy_template(client, arg);
+            break;
+
+        case AXIDMA_GET_BUFFER_HANDLE:
+            if (copy_from_user(&buf_handle, arg_ptr,
+                               sizeof(buf_handle)) != 0) {
+                axidma_err("Unable to copy buffer info from userspace for "
+                           "AXIDMA_GET_BUFFER_HANDLE.\n");
+                return -EFAULT;
+            }
+
+            rc = axidma_get_buffer_handle(client, &buf_handle);
+            if (rc < 0) {
+                break;
+            }
+
+            if (copy_to_user(arg_ptr, &buf_handle, sizeof(buf_handle)) != 0) {
+                axidma_err("Unable to copy buffer handle to userspace for "
+                           "AXIDMA_GET_BUFFER_HANDLE.\n");
+                return -EFAULT;
+            }
+            break;
+
+        case AXIDMA_SYNC_FOR_CPU:
+        case AXIDMA_SYNC_FOR_DEVICE:
+            if (copy_from_user(&sync, arg_ptr, sizeof(sync)) != 0) {
+                axidma_err("Unable to copy sync info from userspace for "
+                           "AXIDMA_SYNC_FOR_CPU/AXIDMA_SYNC_FOR_DEVICE.\n");
+                return -EFAULT;
+            }
+            rc = axidma_sync_buffer(client, &sync,
+                                    cmd == AXIDMA_SYNC_FOR_CPU);
+            break;
+
+        case AXIDMA_CANCEL_TRANSFER:
+            if (copy_from_user(&cancel, arg_ptr, sizeof(cancel)) != 0) {
+                axidma_err("Unable to copy cancel info from userspace for "
+                           "AXIDMA_CANCEL_TRANSFER.\n");
+                return -EFAULT;
+            }
+            rc = axidma_cancel_transfer(client, &cancel);
+            break;
+
+        case AXIDMA_VIDEO_SET_FRAME:
+            if (copy_from_user(&frame_sel, arg_ptr, sizeof(frame_sel)) != 0) {
+                axidma_err("Unable to copy frame selection from userspace "
+                           "for AXIDMA_VIDEO_SET_FRAME.\n");
+                return -EFAULT;
+            }
+            rc = axidma_video_set_frame(client, &frame_sel);
             break;
 
         // Invalid command (already handled in preamble)
@@ -543,6 +1475,108 @@ static const struct file_operations axidma_fops = {
     .unlocked_ioctl = axidma_ioctl,
 };
 
+/*----------------------------------------------------------------------------
+ * Reserved DMA Pool
+ *----------------------------------------------------------------------------*/
+
+/* Sets up the boot-time reserved DMA pool, if one was configured. The pool's
+ * memory comes from a reserved-memory node named by the device tree, or
+ * failing that, from one large coherent allocation sized by the pool_size
+ * module parameter. Buffer allocations are then carved from the pool, which
+ * is nearly instant and immune to CMA fragmentation, no matter how large the
+ * buffer or how long the system has been up. Without a pool, allocations
+ * simply keep going through on-demand coherent allocations. */
+static int axidma_pool_init(struct axidma_device *dev)
+{
+    int rc;
+
+    dev->pool = NULL;
+    dev->pool_coherent = false;
+
+    // Prefer a reserved-memory region named by the device tree
+    rc = axidma_of_parse_reserved_mem(dev->pdev, dev);
+    if (rc < 0) {
+        return rc;
+    }
+
+    if (dev->pool_size > 0) {
+        /* Map the reserved region write-combined, matching the semantics of
+         * a coherent allocation. The region is carved out of the kernel's
+         * memory map at boot, so it cannot fragment or be stolen. */
+        dev->pool_virt = memremap(dev->pool_phys, dev->pool_size,
+                                  MEMREMAP_WC);
+        if (dev->pool_virt == NULL) {
+            axidma_err("Unable to map the reserved DMA pool region.\n");
+            return -ENOMEM;
+        }
+        dev->pool_dma = (dma_addr_t)dev->pool_phys;
+    } else if (dev->pool_fallback_size > 0) {
+        /* Fall back on one large coherent allocation made now, at probe
+         * time, before runtime churn can fragment the CMA area. */
+        dev->pool_size = dev->pool_fallback_size;
+        dev->pool_virt = dma_alloc_coherent(&dev->pdev->dev, dev->pool_size,
+                                            &dev->pool_dma, GFP_KERNEL);
+        if (dev->pool_virt == NULL) {
+            axidma_err("Unable to allocate the fallback DMA pool of size "
+                       "%zu.\n", dev->pool_size);
+            dev->pool_size = 0;
+            return -ENOMEM;
+        }
+        dev->pool_coherent = true;
+    } else {
+        // No pool was configured, which is perfectly fine
+        return 0;
+    }
+
+    // Create the carving allocator over the pool, in page-sized granules
+    dev->pool = gen_pool_create(PAGE_SHIFT, -1);
+    if (dev->pool == NULL) {
+        axidma_err("Unable to create the DMA pool allocator.\n");
+        rc = -ENOMEM;
+        goto free_pool_mem;
+    }
+    rc = gen_pool_add_virt(dev->pool, (unsigned long)dev->pool_virt,
+                           (phys_addr_t)dev->pool_dma, dev->pool_size, -1);
+    if (rc < 0) {
+        axidma_err("Unable to add the pool region to the allocator.\n");
+        gen_pool_destroy(dev->pool);
+        dev->pool = NULL;
+        goto free_pool_mem;
+    }
+
+    axidma_info("Reserved a %zu byte DMA pool at DMA address %pad.\n",
+                dev->pool_size, &dev->pool_dma);
+    return 0;
+
+free_pool_mem:
+    if (dev->pool_coherent) {
+        dma_free_coherent(&dev->pdev->dev, dev->pool_size, dev->pool_virt,
+                          dev->pool_dma);
+    } else {
+        memunmap(dev->pool_virt);
+    }
+    dev->pool_size = 0;
+    return rc;
+}
+
+// Tears down the reserved DMA pool, if one was set up
+static void axidma_pool_exit(struct axidma_device *dev)
+{
+    if (dev->pool == NULL) {
+        return;
+    }
+
+    gen_pool_destroy(dev->pool);
+    if (dev->pool_coherent) {
+        dma_free_coherent(&dev->pdev->dev, dev->pool_size, dev->pool_virt,
+                          dev->pool_dma);
+    } else {
+        memunmap(dev->pool_virt);
+    }
+    dev->pool = NULL;
+    return;
+}
+
 /*----------------------------------------------------------------------------
  * Initialization and Cleanup
  *----------------------------------------------------------------------------*/
@@ -554,12 +1588,18 @@ int axidma_chrdev_init(struct axidma_device *dev)
     // Store a global pointer to the axidma device
     axidma_dev = dev;
 
+    // Set up the reserved DMA pool, if one is configured
+    rc = axidma_pool_init(dev);
+    if (rc < 0) {
+        goto ret;
+    }
+
     // Allocate a major and minor number region for the character device
     rc = alloc_chrdev_region(&dev->dev_num, dev->minor_num, dev->num_devices,
                              dev->chrdev_name);
     if (rc < 0) {
         axidma_err("Unable to allocate character device region.\n");
-        goto ret;
+        goto free_pool;
     }
 
     // Create a device class for our device
@@ -588,10 +1628,6 @@ int axidma_chrdev_init(struct axidma_device *dev)
         goto device_cleanup;
     }
 
-    // Initialize the list for DMA mmap'ed allocations
-    INIT_LIST_HEAD(&dev->dmabuf_list);
-    INIT_LIST_HEAD(&dev->external_dmabufs);
-
     return 0;
 
 device_cleanup:
@@ -600,6 +1636,8 @@ class_cleanup:
     class_destroy(dev->dev_class);
 free_chrdev_region:
     unregister_chrdev_region(dev->dev_num, dev->num_devices);
+free_pool:
+    axidma_pool_exit(dev);
 ret:
     return rc;
 }
@@ -612,5 +1650,7 @@ void axidma_chrdev_exit(struct axidma_device *dev)
     class_destroy(dev->dev_class);
     unregister_chrdev_region(dev->dev_num, dev->num_devices);
 
+    // Release the reserved DMA pool, if one was set up
+    axidma_pool_exit(dev);
     return;
 }
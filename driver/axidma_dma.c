@@ -12,6 +12,7 @@
 // Kernel dependencies
 #include <linux/delay.h>            // Milliseconds to jiffies converstion
 #include <linux/wait.h>             // Completion related functions
+#include <linux/rwsem.h>            // Reader-writer semaphore functions
 
 /* <linux/signal.h> was moved to <linux/sched/signal.h> in the 4.11 kernel */
 #include <linux/version.h>
@@ -21,7 +22,15 @@
 #include <linux/sched/signal.h>     // send_sig_info function
 #endif
 
+#include <linux/debugfs.h>          // Debugfs file creation functions
 #include <linux/dmaengine.h>        // DMA types and functions
+#include <linux/dma-mapping.h>      // Streaming DMA mapping functions
+#include <linux/eventfd.h>          // Eventfd context and signal functions
+#include <linux/file.h>             // File reference counting functions
+#include <linux/ktime.h>            // Monotonic kernel timestamps
+#include <linux/seq_file.h>         // Sequential file operations
+#include <linux/mm.h>               // User page pinning functions
+#include <linux/scatterlist.h>      // Scatter-gather table functions
 #include <linux/slab.h>             // Allocation functions
 #include <linux/errno.h>            // Linux error codes
 #include <linux/platform_device.h>  // Platform device definitions
@@ -40,6 +49,12 @@
 #include "axidma.h"                 // Internal definitions
 #include "axidma_ioctl.h"           // IOCTL interface definition and types
 
+/* The transfer lifecycle tracepoints. The CREATE_TRACE_POINTS macro makes
+ * this inclusion generate the tracepoint definitions, so it must only be
+ * defined in this one translation unit. */
+#define CREATE_TRACE_POINTS
+#include "axidma_trace.h"           // Transfer lifecycle tracepoints
+
 /*----------------------------------------------------------------------------
  * Internal Definitions
  *----------------------------------------------------------------------------*/
@@ -47,11 +62,33 @@
 // The default timeout for DMA is 10 seconds
 #define AXIDMA_DMA_TIMEOUT      10000
 
+/* The number of times a polled transfer spins on the completion status
+ * before it starts yielding between checks. Small transfers complete within
+ * the spin budget, so they never pay for a sleep at all. */
+#define AXIDMA_POLL_SPIN_LIMIT  1000
+
+// The sleep interval in microseconds between polls once the spin budget is up
+#define AXIDMA_POLL_SLEEP_US    10
+
+/* The state for a user buffer pinned in place for a zero-copy transfer. The
+ * pages backing an arbitrary user virtual range are pinned with
+ * get_user_pages, mapped with dma_map_sg, and released again once the
+ * transfer has completed or been terminated. */
+struct axidma_pinned_buffer {
+    struct sg_table sg_table;       // Scatter-gather table over the pages
+    struct page **pages;            // The pinned pages backing the buffer
+    int num_pages;                  // The number of pinned pages
+    enum dma_data_direction map_dir;    // Direction the table was mapped in
+    struct device *map_dev;         // Device the table was mapped for
+};
+
 // A convenient structure to pass between prep and start transfer functions
 struct axidma_transfer {
     int sg_len;                     // The length of the BD array
     struct scatterlist *sg_list;    // List of buffer descriptors
     bool wait;                      // Indicates if we should wait
+    int timeout_ms;                 // Timeout for a waited transfer (0=default)
+    bool canceled;                  // The transfer was abandoned by a cancel
     dma_cookie_t cookie;            // The DMA cookie for the transfer
     struct completion comp;         // A completion to use for waiting
     enum axidma_dir dir;            // The direction of the transfer
@@ -59,7 +96,9 @@ struct axidma_transfer {
     int channel_id;                 // The ID of the channel
     int notify_signal;              // The signal to use for async transfers
     struct task_struct *process;    // The process requesting the transfer
-    struct axidma_cb_data *cb_data; // The callback data struct
+    struct axidma_client *client;   // The client requesting the transfer
+    struct axidma_chan_state *chan_state;   // The channel's in-flight state
+    struct axidma_pinned_buffer *pinned;    // Pinned user pages (optional)
 
     // VDMA specific fields (kept as union for extensability)
     union {
@@ -67,14 +106,95 @@ struct axidma_transfer {
     };
 };
 
-// The data to pass to the DMA transfer completion callback function
+/* The per-channel state for asynchronous transfers. Each channel can have
+ * several transfers in flight at once, so the callback data lives in a
+ * per-transfer allocation, tracked on the channel's outstanding list, rather
+ * than in a single per-channel slot. */
+struct axidma_chan_state {
+    struct eventfd_ctx *efd_ctx;    // For async, eventfd to signal (optional)
+    struct file *efd_file;          // File keeping the eventfd context alive
+    struct list_head outstanding;   // The in-flight transfers on the channel
+    spinlock_t lock;                // Protects the outstanding list
+
+    /* Guards the engine pointer against release. Paths that drive the
+     * engine hold this shared for the duration of the operation; releasing
+     * the engine takes it exclusively, and reports busy rather than
+     * waiting, so a release can never tear the engine down under an
+     * active user, and an active user can never block a release forever. */
+    struct rw_semaphore engine_sem;
+
+    /* Cyclic streaming state. The head counts the ring slots the engine has
+     * filled, and the tail counts the slots user space has consumed; both are
+     * monotonic, so head - tail is the number of slots ready to consume. */
+    bool stream_active;             // A cyclic stream is running
+    struct axidma_client *stream_client;    // The client that started it
+    int stream_periods;             // The number of slots in the stream ring
+    u64 stream_head;                // Slots filled by the engine
+    u64 stream_tail;                // Slots consumed by user space
+    wait_queue_head_t stream_wait;  // Waits for the engine to fill a slot
+
+    /* Interrupt coalescing settings, applied when a transfer is prepared on
+     * the channel. The engine raises one interrupt per `coalesce` completed
+     * transfers, with the delay timer flushing partial batches. */
+    int coalesce;                   // Completions per interrupt
+    int delay;                      // Delay timer for partial batches
+
+    /* VDMA park state. While parked, the engine scans the selected frame
+     * out repeatedly instead of circulating through all of the frame
+     * buffers, which switches the displayed frame on a running transfer
+     * without a stop/start cycle. */
+    bool park;                      // Park on a single frame
+    int park_frm;                   // The index of the frame to park on
+    int video_frames;               // Frames in the running video transfer
+
+    /* Statistics counters, updated under the channel's lock on the submit
+     * and completion paths, and read out through AXIDMA_GET_CHANNEL_STATS
+     * and debugfs. */
+    u64 stat_submitted;             // Transfers submitted to the engine
+    u64 stat_completed;             // Transfers the engine has completed
+    u64 stat_bytes;                 // Bytes moved by completed transfers
+    u64 stat_errors;                // Transfers that failed
+    u64 stat_timeouts;              // Transfers that timed out
+    u64 stat_latency_ns;            // Cumulative submit-to-completion time
+
+    /* Lifecycle timestamps of the most recently completed transfer on the
+     * channel, updated under the lock on the completion path and read out
+     * through AXIDMA_GET_TRANSFER_TIMES, so a latency spike can be
+     * attributed to the correct layer without debug rebuilds. */
+    int last_transfer_id;           // Transfer the timestamps belong to
+    u64 last_submit_ns;             // Transfer submitted by the ioctl
+    u64 last_prep_ns;               // Descriptor chain prepared
+    u64 last_issue_ns;              // Issued to the hardware (0 for batches)
+    u64 last_complete_ns;           // Hardware completion callback ran
+    u64 last_notify_ns;             // Completion delivery finished
+};
+
+/* The data to pass to the DMA transfer completion callback function. One of
+ * these is allocated per transfer, so that submitting a transfer while others
+ * are still in flight on the channel never clobbers their callback data. */
 struct axidma_cb_data {
     int channel_id;                 // The id of the channel used
     int notify_signal;              // For async, signal to send
     struct task_struct *process;    // The process to send the signal to
     struct completion *comp;        // For sync, the notification to kernel
+    struct eventfd_ctx *efd_ctx;    // For async, eventfd to signal (optional)
+    struct file *efd_file;          // File keeping the eventfd context alive
+    struct axidma_client *client;   // The client that submitted the transfer
+    dma_cookie_t cookie;            // The cookie of the prepared transfer
+    bool canceled;                  // The transfer was abandoned by a cancel
+    struct axidma_chan_state *chan_state;   // The channel's in-flight state
+    struct axidma_pinned_buffer *pinned;    // Pinned user pages (optional)
+    bool *template_busy;            // Template busy flag to clear (optional)
+    size_t num_bytes;               // Total bytes moved by the transfer
+    u64 submit_ns;                  // Timestamp of the transfer's submission
+    u64 prep_ns;                    // Timestamp of the descriptor preparation
+    u64 issue_ns;                   // Timestamp of the issue to the hardware
+    struct list_head list;          // Entry in the outstanding list
 };
 
+// Checks that the channel is not claimed by another open file (defined below)
+static int axidma_check_owner(struct axidma_client *client, int channel_id);
+
 /*----------------------------------------------------------------------------
  * Enumeration Conversions
  *----------------------------------------------------------------------------*/
@@ -102,17 +222,40 @@ static enum dma_transfer_direction axidma_to_dma_dir(enum axidma_dir dma_dir)
  * DMA Operations Helper Functions
  *----------------------------------------------------------------------------*/
 
-static int axidma_init_sg_entry(struct axidma_device *dev,
-        struct scatterlist *sg_list, int index, void *buf, size_t buf_len)
+/* Converts a per-transfer timeout in milliseconds into jiffies, falling back
+ * to the driver-wide default when the caller left the timeout at zero. */
+static unsigned long axidma_timeout_jiffies(int timeout_ms)
+{
+    if (timeout_ms <= 0) {
+        timeout_ms = AXIDMA_DMA_TIMEOUT;
+    }
+    return msecs_to_jiffies(timeout_ms);
+}
+
+static int axidma_init_sg_entry(struct axidma_client *client,
+        struct scatterlist *sg_list, int index, void *buf, size_t buf_len,
+        int buf_handle)
 {
     dma_addr_t dma_addr;
 
-    // Get the DMA address from the user virtual address
-    dma_addr = axidma_uservirt_to_dma(dev, buf, buf_len);
-    if (dma_addr == (dma_addr_t)NULL) {
-        axidma_err("Requested transfer address %p does not fall within a "
-                   "previously allocated DMA buffer.\n", buf);
-        return -EFAULT;
+    /* For a pre-resolved buffer handle, the DMA address was resolved when
+     * the handle was created, and `buf` carries the byte offset into the
+     * handle's buffer. Otherwise, translate the user virtual address. */
+    if (buf_handle > 0) {
+        dma_addr = axidma_handle_to_dma(client, buf_handle, (size_t)buf,
+                                        buf_len);
+        if (dma_addr == (dma_addr_t)NULL) {
+            axidma_err("Requested buffer handle %d with offset %zu is not a "
+                       "live buffer handle.\n", buf_handle, (size_t)buf);
+            return -EFAULT;
+        }
+    } else {
+        dma_addr = axidma_uservirt_to_dma(client, buf, buf_len);
+        if (dma_addr == (dma_addr_t)NULL) {
+            axidma_err("Requested transfer address %p does not fall within a "
+                       "previously allocated DMA buffer.\n", buf);
+            return -EFAULT;
+        }
     }
 
     // Initialize the scatter-gather table entry
@@ -122,21 +265,235 @@ static int axidma_init_sg_entry(struct axidma_device *dev,
     return 0;
 }
 
+/* Builds the scatter-gather list describing the given user buffer. Buffers
+ * are almost always one contiguous segment, which is served from the
+ * caller's stack entry with no allocation. Imported external buffers can
+ * span several physical segments; those get an allocated list, which the
+ * caller must free when *sg_out differs from sg_entry. Returns the number
+ * of entries in the list, or a negative error. */
+static int axidma_build_sg_list(struct axidma_client *client, void *buf,
+        size_t buf_len, int buf_handle, struct scatterlist *sg_entry,
+        struct scatterlist **sg_out)
+{
+    int rc, sg_len;
+    struct scatterlist *sg_list;
+
+    // Pre-resolved buffer handles always name a contiguous region
+    if (buf_handle > 0) {
+        sg_len = 1;
+    } else {
+        sg_len = axidma_uservirt_sg_count(client, buf, buf_len);
+        if (sg_len < 0) {
+            axidma_err("Requested transfer address %p does not fall within a "
+                       "previously allocated DMA buffer.\n", buf);
+            return sg_len;
+        }
+    }
+
+    // Contiguous buffers take the single-entry fast path
+    if (sg_len == 1) {
+        sg_init_table(sg_entry, 1);
+        rc = axidma_init_sg_entry(client, sg_entry, 0, buf, buf_len,
+                                  buf_handle);
+        if (rc < 0) {
+            return rc;
+        }
+        *sg_out = sg_entry;
+        return 1;
+    }
+
+    // Allocate and fill one entry per physical segment of the buffer
+    sg_list = kmalloc(sg_len * sizeof(*sg_list), GFP_KERNEL);
+    if (sg_list == NULL) {
+        axidma_err("Unable to allocate memory for the scatter-gather list.\n");
+        return -ENOMEM;
+    }
+    sg_init_table(sg_list, sg_len);
+    rc = axidma_uservirt_to_sg(client, buf, buf_len, sg_list, sg_len);
+    if (rc < 0) {
+        kfree(sg_list);
+        return rc;
+    }
+
+    *sg_out = sg_list;
+    return sg_len;
+}
+
 static struct axidma_chan *axidma_get_chan(struct axidma_device *dev,
         int channel_id)
 {
-    int i;
+    /* Channel ids are validated to be unique and in range when the device
+     * tree is parsed, so the channel is found with a direct table index
+     * instead of a scan. This lookup sits on every transfer path. */
+    if (channel_id < 0 || channel_id >= dev->num_chans) {
+        return NULL;
+    }
+    return dev->chan_index[channel_id];
+}
+
+/* Lazily acquires the DMA engine backing the given channel. The engines are
+ * not requested at probe time, so module insertion only pays for the
+ * channels a deployment actually uses, and unused engines stay available to
+ * other kernel consumers. The mutex serializes concurrent first uses of the
+ * same channel. Callers must hold the channel's engine semaphore shared,
+ * which keeps a concurrent release from clearing the engine pointer, so the
+ * fast path is a single pointer check. */
+static int axidma_engine_acquire(struct axidma_device *dev,
+                                 struct axidma_chan *chan)
+{
+    if (chan->chan != NULL) {
+        return 0;
+    }
+
+    mutex_lock(&dev->engine_lock);
+    if (chan->chan == NULL) {
+        chan->chan = dma_request_slave_channel(&dev->pdev->dev, chan->name);
+    }
+    mutex_unlock(&dev->engine_lock);
+
+    if (chan->chan == NULL) {
+        axidma_err("Unable to get slave channel %d: %s.\n", chan->channel_id,
+                   chan->name);
+        return -ENODEV;
+    }
+    return 0;
+}
+
+/* Looks up the channel with the given id, and makes sure its DMA engine is
+ * acquired. Every operation that drives the engine goes through this instead
+ * of axidma_get_chan, which only needs the channel's metadata. On success,
+ * the channel's engine semaphore is held shared, so the engine cannot be
+ * released out from under the operation; the caller drops it with
+ * axidma_put_engine once it is done driving the engine. */
+static struct axidma_chan *axidma_get_engine(struct axidma_device *dev,
+        int channel_id)
+{
     struct axidma_chan *chan;
 
-    // Find the channel with the given ID that matches the type and direction
-    for (i = 0; i < dev->num_chans; i++)
+    chan = axidma_get_chan(dev, channel_id);
+    if (chan == NULL) {
+        return NULL;
+    }
+
+    down_read(&dev->chan_states[channel_id].engine_sem);
+    if (axidma_engine_acquire(dev, chan) < 0) {
+        up_read(&dev->chan_states[channel_id].engine_sem);
+        return NULL;
+    }
+    return chan;
+}
+
+// Drops the engine semaphore taken by a successful axidma_get_engine
+static void axidma_put_engine(struct axidma_device *dev,
+                              struct axidma_chan *chan)
+{
+    up_read(&dev->chan_states[chan->channel_id].engine_sem);
+    return;
+}
+
+/* Unmaps and releases a user buffer that was pinned for a zero-copy transfer.
+ * For receive transfers, the pages are marked dirty, since the device wrote
+ * to them behind the kernel's back. The non-locking set_page_dirty is used,
+ * as this runs from the completion callback in atomic context. */
+static void axidma_unpin_user_buffer(struct axidma_pinned_buffer *pinned)
+{
+    int i;
+
+    dma_unmap_sg(pinned->map_dev, pinned->sg_table.sgl,
+                 pinned->sg_table.orig_nents, pinned->map_dir);
+    sg_free_table(&pinned->sg_table);
+
+    for (i = 0; i < pinned->num_pages; i++)
     {
-        chan = &dev->channels[i];
-        if (chan->channel_id == channel_id) {
-            return chan;
+        if (pinned->map_dir == DMA_FROM_DEVICE) {
+            set_page_dirty(pinned->pages[i]);
         }
+        put_page(pinned->pages[i]);
+    }
+
+    kfree(pinned->pages);
+    kfree(pinned);
+    return;
+}
+
+/* Pins the pages backing an arbitrary user virtual range in place, and maps
+ * them for streaming DMA as a scatter-gather table. The caller owns the
+ * returned structure until the transfer is successfully prepared, after which
+ * it is released by the transfer's completion callback. */
+static struct axidma_pinned_buffer *axidma_pin_user_buffer(
+        struct axidma_device *dev, void *user_addr, size_t size,
+        enum axidma_dir dir)
+{
+    int rc, i, num_pages, mapped_nents;
+    unsigned long start, offset;
+    struct axidma_pinned_buffer *pinned;
+
+    // Compute the page-aligned start and the number of pages in the range
+    start = (unsigned long)user_addr & PAGE_MASK;
+    offset = (unsigned long)user_addr & ~PAGE_MASK;
+    num_pages = DIV_ROUND_UP(offset + size, PAGE_SIZE);
+
+    // Allocate the tracking structure and the page pointer array
+    pinned = kmalloc(sizeof(*pinned), GFP_KERNEL);
+    if (pinned == NULL) {
+        axidma_err("Unable to allocate the pinned buffer structure.\n");
+        return NULL;
+    }
+    pinned->pages = kmalloc(num_pages * sizeof(pinned->pages[0]), GFP_KERNEL);
+    if (pinned->pages == NULL) {
+        axidma_err("Unable to allocate the pinned page array.\n");
+        goto free_pinned;
+    }
+
+    /* Pin the user pages in place. The pages must be writable for a receive
+     * transfer, since the device will store into them. */
+    rc = get_user_pages_fast(start, num_pages, dir == AXIDMA_READ,
+                             pinned->pages);
+    if (rc < 0) {
+        axidma_err("Unable to pin the buffer at address %p (error %d).\n",
+                   user_addr, rc);
+        goto free_pages_array;
+    } else if (rc < num_pages) {
+        axidma_err("Only pinned %d of %d pages for the buffer at address "
+                   "%p.\n", rc, num_pages, user_addr);
+        num_pages = rc;
+        goto put_pages;
+    }
+    pinned->num_pages = num_pages;
+
+    // Build a scatter-gather table over the pinned pages
+    rc = sg_alloc_table_from_pages(&pinned->sg_table, pinned->pages,
+                                   num_pages, offset, size, GFP_KERNEL);
+    if (rc < 0) {
+        axidma_err("Unable to allocate a scatter-gather table for the "
+                   "buffer.\n");
+        goto put_pages;
+    }
+
+    // Map the table for streaming DMA with the device
+    pinned->map_dev = &dev->pdev->dev;
+    pinned->map_dir = (dir == AXIDMA_WRITE) ? DMA_TO_DEVICE : DMA_FROM_DEVICE;
+    mapped_nents = dma_map_sg(pinned->map_dev, pinned->sg_table.sgl,
+                              pinned->sg_table.orig_nents, pinned->map_dir);
+    if (mapped_nents == 0) {
+        axidma_err("Unable to map the pinned buffer for DMA.\n");
+        goto free_sg_table;
     }
+    pinned->sg_table.nents = mapped_nents;
 
+    return pinned;
+
+free_sg_table:
+    sg_free_table(&pinned->sg_table);
+put_pages:
+    for (i = 0; i < num_pages; i++)
+    {
+        put_page(pinned->pages[i]);
+    }
+free_pages_array:
+    kfree(pinned->pages);
+free_pinned:
+    kfree(pinned);
     return NULL;
 }
 
@@ -144,33 +501,153 @@ static void axidma_dma_callback(void *data)
 {
     struct axidma_cb_data *cb_data;
     struct siginfo sig_info;
+    unsigned long flags;
+    u64 complete_ns;
+    bool canceled;
 
-    /* For synchronous transfers, notify the kernel thread waiting. For
-     * asynchronous transfers, send a signal to userspace if requested. */
     cb_data = data;
-    if (cb_data->comp != NULL) {
-        complete(cb_data->comp);
-    } else if (VALID_NOTIFY_SIGNAL(cb_data->notify_signal)) {
-        memset(&sig_info, 0, sizeof(sig_info));
-        sig_info.si_signo = cb_data->notify_signal;
-        sig_info.si_code = SI_QUEUE;
-        sig_info.si_int = cb_data->channel_id;
-        send_sig_info(cb_data->notify_signal, &sig_info, cb_data->process);
+    complete_ns = ktime_get_ns();
+
+    /* The transfer is no longer in flight, so account for its completion
+     * and take it off the outstanding list. The canceled flag must be
+     * observed under the channel's lock, since a concurrent cancel sets it
+     * there while clearing the completion pointer. */
+    spin_lock_irqsave(&cb_data->chan_state->lock, flags);
+    canceled = cb_data->canceled;
+    cb_data->chan_state->stat_completed += 1;
+    cb_data->chan_state->stat_bytes += cb_data->num_bytes;
+    cb_data->chan_state->stat_latency_ns += complete_ns - cb_data->submit_ns;
+    list_del(&cb_data->list);
+    if (cb_data->template_busy != NULL) {
+        *cb_data->template_busy = false;
+    }
+    spin_unlock_irqrestore(&cb_data->chan_state->lock, flags);
+
+    trace_axidma_transfer_complete(cb_data->channel_id, cb_data->cookie,
+                                   cb_data->num_bytes);
+
+    /* For synchronous transfers, notify the kernel thread waiting. For
+     * asynchronous transfers, signal the channel's eventfd if one was
+     * registered, and otherwise send a signal to userspace if requested.
+     * A canceled transfer was abandoned by its submitter, so it is retired
+     * silently, without reaching any of the notification paths. */
+    if (!canceled) {
+        // Record the completion in the shared completion ring, if mapped
+        axidma_cq_record(cb_data->client, cb_data->channel_id,
+                         cb_data->cookie);
+
+        if (cb_data->comp != NULL) {
+            complete(cb_data->comp);
+        } else if (cb_data->efd_ctx != NULL) {
+            eventfd_signal(cb_data->efd_ctx, 1);
+        } else if (VALID_NOTIFY_SIGNAL(cb_data->notify_signal)) {
+            memset(&sig_info, 0, sizeof(sig_info));
+            sig_info.si_signo = cb_data->notify_signal;
+            sig_info.si_code = SI_QUEUE;
+            sig_info.si_int = cb_data->channel_id;
+            send_sig_info(cb_data->notify_signal, &sig_info, cb_data->process);
+        }
+        trace_axidma_transfer_notify(cb_data->channel_id, cb_data->cookie,
+                                     cb_data->num_bytes);
+
+        /* Publish the stage timestamps as the channel's last completed
+         * transfer, so user space can query them afterwards. */
+        spin_lock_irqsave(&cb_data->chan_state->lock, flags);
+        cb_data->chan_state->last_transfer_id = cb_data->cookie;
+        cb_data->chan_state->last_submit_ns = cb_data->submit_ns;
+        cb_data->chan_state->last_prep_ns = cb_data->prep_ns;
+        cb_data->chan_state->last_issue_ns = cb_data->issue_ns;
+        cb_data->chan_state->last_complete_ns = complete_ns;
+        cb_data->chan_state->last_notify_ns = ktime_get_ns();
+        spin_unlock_irqrestore(&cb_data->chan_state->lock, flags);
+    }
+
+    // If the transfer used pinned user pages, unmap and release them
+    if (cb_data->pinned != NULL) {
+        axidma_unpin_user_buffer(cb_data->pinned);
+    }
+
+    // Drop the file reference that kept the eventfd context alive
+    if (cb_data->efd_file != NULL) {
+        fput(cb_data->efd_file);
+    }
+    kfree(cb_data);
+}
+
+/* The completion callback for cyclic streaming transfers. The DMA engine
+ * invokes this once per ring slot it finishes, so advancing the head index
+ * publishes the slot to user space. */
+static void axidma_stream_callback(void *data)
+{
+    struct axidma_chan_state *chan_state;
+    unsigned long flags;
+
+    chan_state = data;
+    spin_lock_irqsave(&chan_state->lock, flags);
+    chan_state->stream_head += 1;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    wake_up_interruptible(&chan_state->stream_wait);
+    return;
+}
+
+// Accounts for a failed or timed-out transfer in the channel's statistics
+static void axidma_stat_failure(struct axidma_chan_state *chan_state,
+                                bool timed_out)
+{
+    unsigned long flags;
+
+    spin_lock_irqsave(&chan_state->lock, flags);
+    if (timed_out) {
+        chan_state->stat_timeouts += 1;
+    } else {
+        chan_state->stat_errors += 1;
+    }
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+    return;
+}
+
+/* Retires the callback data of every outstanding transfer on the channel.
+ * This must only be called after the channel has been terminated
+ * synchronously, so that no completion callback can still be running, or
+ * about to run, for the transfers being retired. */
+static void axidma_flush_outstanding(struct axidma_chan_state *chan_state)
+{
+    unsigned long flags;
+    struct axidma_cb_data *cb_data, *tmp;
+
+    spin_lock_irqsave(&chan_state->lock, flags);
+    list_for_each_entry_safe(cb_data, tmp, &chan_state->outstanding, list)
+    {
+        list_del(&cb_data->list);
+        if (cb_data->pinned != NULL) {
+            axidma_unpin_user_buffer(cb_data->pinned);
+        }
+        if (cb_data->efd_file != NULL) {
+            fput(cb_data->efd_file);
+        }
+        if (cb_data->template_busy != NULL) {
+            *cb_data->template_busy = false;
+        }
+        kfree(cb_data);
     }
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+    return;
 }
 
 // Setup the config structure for VDMA
-static void axidma_setup_vdma_config(struct xilinx_vdma_config *dma_config)
+static void axidma_setup_vdma_config(struct xilinx_vdma_config *dma_config,
+                                     struct axidma_chan_state *chan_state)
 {
     memset(dma_config, 0, sizeof(*dma_config));
     dma_config->frm_dly = 0;            // Number of frames to delay
     dma_config->gen_lock = 0;           // Genlock, VDMA runs on fsyncs
     dma_config->master = 0;             // VDMA is the genlock master
     dma_config->frm_cnt_en = 1;         // Interrupt based on frame count
-    dma_config->park = 0;               // Continuously process all frames
-    dma_config->park_frm = 0;           // Frame to stop (park) at (N/A)
-    dma_config->coalesc = 1;            // Interrupt after one frame completion
-    dma_config->delay = 0;              // Disable the delay counter interrupt
+    dma_config->park = chan_state->park;    // Park on one frame, or cycle
+    dma_config->park_frm = chan_state->park_frm;    // Frame to park at
+    dma_config->coalesc = chan_state->coalesce; // Completions per interrupt
+    dma_config->delay = chan_state->delay;  // Delay for partial batches
     dma_config->reset = 0;              // Don't reset the channel
     dma_config->ext_fsync = 0;          // VDMA handles synchronizes itself
     return;
@@ -191,8 +668,9 @@ static int axidma_prep_transfer(struct axidma_chan *axidma_chan,
     struct scatterlist *sg_list;
     int sg_len;
     dma_cookie_t dma_cookie;
+    unsigned long flags;
     char *direction, *type;
-    int rc;
+    int rc, i;
 
     // Get the fields from the structures
     chan = axidma_chan->chan;
@@ -203,7 +681,28 @@ static int axidma_prep_transfer(struct axidma_chan *axidma_chan,
     sg_len = dma_tfr->sg_len;
     direction = axidma_dir_to_string(dma_tfr->dir);
     type = axidma_type_to_string(dma_tfr->type);
-    cb_data = dma_tfr->cb_data;
+
+    /* Allocate the callback data for this transfer. Each in-flight transfer
+     * carries its own callback data, so a channel can queue several transfers
+     * without one submission clobbering another's completion state. */
+    cb_data = kmalloc(sizeof(*cb_data), GFP_KERNEL);
+    if (cb_data == NULL) {
+        axidma_err("Unable to allocate callback data for the transfer.\n");
+        return -ENOMEM;
+    }
+
+    // Count the total number of bytes the transfer will move
+    cb_data->num_bytes = 0;
+    for (i = 0; i < sg_len; i++)
+    {
+        cb_data->num_bytes += sg_dma_len(&sg_list[i]);
+    }
+
+    /* Stamp the submission stage. The issue timestamp stays at zero until
+     * the transfer is issued, which batch submissions never stamp. */
+    cb_data->submit_ns = ktime_get_ns();
+    cb_data->issue_ns = 0;
+    trace_axidma_transfer_submit(dma_tfr->channel_id, 0, cb_data->num_bytes);
 
     /* For VDMA transfers, we configure the channel, then prepare an interlaved
      * transfer. For DMA, we simply prepare a slave scatter-gather transfer. */
@@ -212,11 +711,11 @@ static int axidma_prep_transfer(struct axidma_chan *axidma_chan,
         dma_txnd = dmaengine_prep_slave_sg(chan, sg_list, sg_len, dma_dir,
                                            dma_flags);
     } else {
-        axidma_setup_vdma_config(&vdma_config);
+        axidma_setup_vdma_config(&vdma_config, dma_tfr->chan_state);
         rc = xilinx_vdma_channel_set_config(chan, &vdma_config);
         if (rc < 0) {
             axidma_err("Unable to set the config for channel.\n");
-            goto stop_dma;
+            goto free_cb_data;
         }
 
         memset(&dma_template, 0, sizeof(dma_template));
@@ -235,12 +734,22 @@ static int axidma_prep_transfer(struct axidma_chan *axidma_chan,
         axidma_err("Unable to prepare the dma engine for the %s %s buffer.\n",
                    type, direction);
         rc = -EBUSY;
-        goto stop_dma;
+        goto free_cb_data;
     }
 
+    // Stamp the descriptor preparation stage
+    cb_data->prep_ns = ktime_get_ns();
+    trace_axidma_transfer_prep(dma_tfr->channel_id, 0, cb_data->num_bytes);
+
     /* If we're going to wait for this channel, initialize the completion for
      * the channel, and setup the callback to complete it. */
     cb_data->channel_id = dma_tfr->channel_id;
+    cb_data->client = dma_tfr->client;
+    cb_data->chan_state = dma_tfr->chan_state;
+    cb_data->pinned = dma_tfr->pinned;
+    cb_data->template_busy = NULL;
+    cb_data->canceled = false;
+    dma_tfr->canceled = false;
     if (dma_tfr->wait) {
         cb_data->comp = dma_comp;
         cb_data->notify_signal = -1;
@@ -255,6 +764,21 @@ static int axidma_prep_transfer(struct axidma_chan *axidma_chan,
         dma_txnd->callback_param = cb_data;
         dma_txnd->callback = axidma_dma_callback;
     }
+
+    /* Track the transfer on the channel's outstanding list, so its callback
+     * data can be retired if the channel is terminated. The eventfd is
+     * snapshotted under the same lock, with a file reference taken so that
+     * the context outlives any concurrent re-registration. */
+    spin_lock_irqsave(&dma_tfr->chan_state->lock, flags);
+    cb_data->efd_ctx = dma_tfr->chan_state->efd_ctx;
+    cb_data->efd_file = dma_tfr->chan_state->efd_file;
+    if (cb_data->efd_file != NULL) {
+        get_file(cb_data->efd_file);
+    }
+    dma_tfr->chan_state->stat_submitted += 1;
+    list_add_tail(&cb_data->list, &dma_tfr->chan_state->outstanding);
+    spin_unlock_irqrestore(&dma_tfr->chan_state->lock, flags);
+
     dma_cookie = dmaengine_submit(dma_txnd);
     if (dma_submit_error(dma_cookie)) {
         axidma_err("Unable to submit the %s %s transaction to the engine.\n",
@@ -265,10 +789,24 @@ static int axidma_prep_transfer(struct axidma_chan *axidma_chan,
 
     // Return the DMA cookie for the transaction
     dma_tfr->cookie = dma_cookie;
+    cb_data->cookie = dma_cookie;
     return 0;
 
 stop_dma:
-    dmaengine_terminate_all(chan);
+    /* The callback data is already on the outstanding list at this point, so
+     * the flush retires it along with any other terminated transfers. Any
+     * pinned pages stay owned by the caller, who releases them on failure. */
+    cb_data->pinned = NULL;
+    dmaengine_terminate_sync(chan);
+    axidma_flush_outstanding(dma_tfr->chan_state);
+    axidma_stat_failure(dma_tfr->chan_state, false);
+    return rc;
+
+free_cb_data:
+    dmaengine_terminate_sync(chan);
+    axidma_flush_outstanding(dma_tfr->chan_state);
+    axidma_stat_failure(dma_tfr->chan_state, false);
+    kfree(cb_data);
     return rc;
 }
 
@@ -276,10 +814,12 @@ static int axidma_start_transfer(struct axidma_chan *chan,
                                  struct axidma_transfer *dma_tfr)
 {
     struct completion *dma_comp;
+    struct axidma_cb_data *cb_data;
     dma_cookie_t dma_cookie;
     enum dma_status status;
     char *direction, *type;
-    unsigned long timeout, time_remain;
+    unsigned long flags, timeout, time_remain;
+    bool canceled;
     int rc;
 
     // Get the fields from the structures
@@ -288,22 +828,54 @@ static int axidma_start_transfer(struct axidma_chan *chan,
     direction = axidma_dir_to_string(dma_tfr->dir);
     type = axidma_type_to_string(dma_tfr->type);
 
+    /* Stamp the issue stage on the transfer's callback data. The data is
+     * found on the channel's outstanding list under the lock, since a
+     * concurrent issue by another submitter on the same channel could have
+     * started, completed, and retired the transfer already. */
+    spin_lock_irqsave(&dma_tfr->chan_state->lock, flags);
+    list_for_each_entry(cb_data, &dma_tfr->chan_state->outstanding, list)
+    {
+        if (cb_data->cookie == dma_cookie) {
+            cb_data->issue_ns = ktime_get_ns();
+            trace_axidma_transfer_issue(dma_tfr->channel_id, dma_cookie,
+                                        cb_data->num_bytes);
+            break;
+        }
+    }
+    spin_unlock_irqrestore(&dma_tfr->chan_state->lock, flags);
+
     // Flush all pending transaction in the dma engine for this channel
     dma_async_issue_pending(chan->chan);
 
     // Wait for the completion timeout or the DMA to complete
     if (dma_tfr->wait) {
-        timeout = msecs_to_jiffies(AXIDMA_DMA_TIMEOUT);
+        timeout = axidma_timeout_jiffies(dma_tfr->timeout_ms);
         time_remain = wait_for_completion_timeout(dma_comp, timeout);
         status = dma_async_is_tx_complete(chan->chan, dma_cookie, NULL, NULL);
 
+        /* A canceled transfer releases its waiter without terminating the
+         * channel, so the transfers queued behind it are undisturbed. Its
+         * callback data is retired by the eventual completion callback, or
+         * by the flush when the channel is eventually terminated. The flag
+         * must be read under the channel's lock, so that a cancel racing
+         * with the wait timing out cannot touch the transfer structure
+         * after the waiter has returned. */
+        spin_lock_irqsave(&dma_tfr->chan_state->lock, flags);
+        canceled = dma_tfr->canceled;
+        spin_unlock_irqrestore(&dma_tfr->chan_state->lock, flags);
+        if (canceled) {
+            return -ECANCELED;
+        }
+
         if (time_remain == 0) {
             axidma_err("%s %s transaction timed out.\n", type, direction);
+            axidma_stat_failure(dma_tfr->chan_state, true);
             rc = -ETIME;
             goto stop_dma;
         } else if (status != DMA_COMPLETE) {
             axidma_err("%s %s transaction did not succceed. Status is %d.\n",
                        type, direction, status);
+            axidma_stat_failure(dma_tfr->chan_state, false);
             rc = -EBUSY;
             goto stop_dma;
         }
@@ -312,7 +884,8 @@ static int axidma_start_transfer(struct axidma_chan *chan,
     return 0;
 
 stop_dma:
-    dmaengine_terminate_all(chan->chan);
+    dmaengine_terminate_sync(chan->chan);
+    axidma_flush_outstanding(dma_tfr->chan_state);
     return rc;
 }
 
@@ -338,6 +911,65 @@ void axidma_get_channel_info(struct axidma_device *dev,
     return;
 }
 
+int axidma_get_channel_stats(struct axidma_device *dev,
+                             struct axidma_chan_stats *stats)
+{
+    unsigned long flags;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+
+    // Get the channel with the given channel id
+    chan = axidma_get_chan(dev, stats->channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for statistics query.\n",
+                   stats->channel_id);
+        return -ENODEV;
+    }
+
+    // Snapshot the channel's counters under its lock
+    chan_state = &dev->chan_states[stats->channel_id];
+    spin_lock_irqsave(&chan_state->lock, flags);
+    stats->submitted = chan_state->stat_submitted;
+    stats->completed = chan_state->stat_completed;
+    stats->bytes = chan_state->stat_bytes;
+    stats->errors = chan_state->stat_errors;
+    stats->timeouts = chan_state->stat_timeouts;
+    stats->latency_ns = chan_state->stat_latency_ns;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    return 0;
+}
+
+int axidma_get_transfer_times(struct axidma_device *dev,
+                              struct axidma_transfer_times *times)
+{
+    unsigned long flags;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+
+    // Get the channel with the given channel id
+    chan = axidma_get_chan(dev, times->channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for transfer times query.\n",
+                   times->channel_id);
+        return -ENODEV;
+    }
+
+    /* Snapshot the stage timestamps of the channel's last completed
+     * transfer under its lock */
+    chan_state = &dev->chan_states[times->channel_id];
+    spin_lock_irqsave(&chan_state->lock, flags);
+    times->transfer_id = chan_state->last_transfer_id;
+    times->submit_ns = chan_state->last_submit_ns;
+    times->prep_ns = chan_state->last_prep_ns;
+    times->issue_ns = chan_state->last_issue_ns;
+    times->complete_ns = chan_state->last_complete_ns;
+    times->notify_ns = chan_state->last_notify_ns;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    return 0;
+}
+
 int axidma_set_signal(struct axidma_device *dev, int signal)
 {
     // Verify the signal is a real-time one
@@ -352,155 +984,1371 @@ int axidma_set_signal(struct axidma_device *dev, int signal)
     return 0;
 }
 
-int axidma_read_transfer(struct axidma_device *dev,
-                         struct axidma_transaction *trans)
+int axidma_set_eventfd(struct axidma_client *client, struct axidma_eventfd *efd)
 {
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+    struct eventfd_ctx *efd_ctx, *old_ctx;
+    struct file *efd_file, *old_file;
+    unsigned long flags;
     int rc;
-    struct axidma_chan *rx_chan;
-    struct scatterlist sg_list;
-    struct axidma_transfer rx_tfr;
 
     // Get the channel with the given channel id
-    rx_chan = axidma_get_chan(dev, trans->channel_id);
-    if (rx_chan == NULL || rx_chan->dir != AXIDMA_READ) {
-        axidma_err("Invalid device id %d for DMA receive channel.\n",
-                   trans->channel_id);
+    dev = client->dev;
+    chan = axidma_get_chan(dev, efd->channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for eventfd registration.\n",
+                   efd->channel_id);
         return -ENODEV;
     }
 
-    // Setup the scatter-gather list for the transfer (only one entry)
-    sg_init_table(&sg_list, 1);
-    rc = axidma_init_sg_entry(dev, &sg_list, 0, trans->buf,
-                              trans->buf_len);
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, efd->channel_id);
     if (rc < 0) {
         return rc;
     }
 
-    // Setup receive transfer structure for DMA
-    rx_tfr.sg_list = &sg_list;
-    rx_tfr.sg_len = 1;
-    rx_tfr.dir = rx_chan->dir;
-    rx_tfr.type = rx_chan->type;
-    rx_tfr.wait = trans->wait;
-    rx_tfr.channel_id = trans->channel_id;
-    rx_tfr.notify_signal = dev->notify_signal;
-    rx_tfr.process = get_current();
-    rx_tfr.cb_data = &dev->cb_data[trans->channel_id];
-
-    // Prepare the receive transfer
-    rc = axidma_prep_transfer(rx_chan, &rx_tfr);
-    if (rc < 0) {
-        return rc;
+    /* Look up the new eventfd before touching the registration. The file
+     * reference, rather than a bare context reference, is what keeps the
+     * context alive, so in-flight transfers can hold it across a swap. */
+    efd_ctx = NULL;
+    efd_file = NULL;
+    if (efd->fd >= 0) {
+        efd_file = fget(efd->fd);
+        if (efd_file == NULL) {
+            axidma_err("Invalid eventfd file descriptor %d.\n", efd->fd);
+            return -EBADF;
+        }
+        efd_ctx = eventfd_ctx_fileget(efd_file);
+        if (IS_ERR(efd_ctx)) {
+            axidma_err("File descriptor %d is not an eventfd.\n", efd->fd);
+            fput(efd_file);
+            return PTR_ERR(efd_ctx);
+        }
     }
 
-    // Submit the receive transfer, and wait for it to complete
-    rc = axidma_start_transfer(rx_chan, &rx_tfr);
-    if (rc < 0) {
-        return rc;
+    /* Swap the registration under the channel's lock, so that a transfer
+     * being submitted concurrently snapshots either the old eventfd or the
+     * new one, never a half-released one. */
+    chan_state = &dev->chan_states[efd->channel_id];
+    spin_lock_irqsave(&chan_state->lock, flags);
+    old_ctx = chan_state->efd_ctx;
+    old_file = chan_state->efd_file;
+    chan_state->efd_ctx = efd_ctx;
+    chan_state->efd_file = efd_file;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    // Release the previous registration, if the channel had one
+    if (old_ctx != NULL) {
+        eventfd_ctx_put(old_ctx);
+        fput(old_file);
     }
-
     return 0;
 }
 
-int axidma_write_transfer(struct axidma_device *dev,
-                          struct axidma_transaction *trans)
+int axidma_set_coalescing(struct axidma_device *dev,
+                          struct axidma_coalesce *coal)
 {
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+#ifdef XILINX_DMA_HAS_DMA_CONFIG
     int rc;
-    struct axidma_chan *tx_chan;
-    struct scatterlist sg_list;
-    struct axidma_transfer tx_tfr;
+    struct xilinx_dma_config dma_config;
+#endif
 
-    // Get the channel with the given id
-    tx_chan = axidma_get_chan(dev, trans->channel_id);
-    if (tx_chan == NULL || tx_chan->dir != AXIDMA_WRITE) {
-        axidma_err("Invalid device id %d for DMA transmit channel.\n",
-                   trans->channel_id);
+    // Get the channel with the given channel id
+    chan = axidma_get_engine(dev, coal->channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for coalescing setup.\n",
+                   coal->channel_id);
         return -ENODEV;
     }
 
-    // Setup the scatter-gather list for the transfer (only one entry)
-    sg_init_table(&sg_list, 1);
-    rc = axidma_init_sg_entry(dev, &sg_list, 0, trans->buf,
-                              trans->buf_len);
-    if (rc < 0) {
-        return rc;
+    // The engine's coalescing count and delay timer are 8-bit registers
+    if (coal->coalesce < 1 || coal->coalesce > 255 || coal->delay < 0 ||
+            coal->delay > 255) {
+        axidma_err("Coalescing count %d or delay %d is out of range.\n",
+                   coal->coalesce, coal->delay);
+        axidma_put_engine(dev, chan);
+        return -EINVAL;
     }
 
-    // Setup transmit transfer structure for DMA
-    tx_tfr.sg_list = &sg_list;
-    tx_tfr.sg_len = 1;
-    tx_tfr.dir = tx_chan->dir;
-    tx_tfr.type = tx_chan->type;
-    tx_tfr.wait = trans->wait;
-    tx_tfr.channel_id = trans->channel_id;
-    tx_tfr.notify_signal = dev->notify_signal;
-    tx_tfr.process = get_current();
-    tx_tfr.cb_data = &dev->cb_data[trans->channel_id];
-
-    // Prepare the transmit transfer
-    rc = axidma_prep_transfer(tx_chan, &tx_tfr);
-    if (rc < 0) {
-        return rc;
+    /* Record the settings for the channel. VDMA channels pick them up in the
+     * channel configuration when the next transfer is prepared. */
+    chan_state = &dev->chan_states[coal->channel_id];
+    chan_state->coalesce = coal->coalesce;
+    chan_state->delay = coal->delay;
+
+#ifdef XILINX_DMA_HAS_DMA_CONFIG
+    /* On Xilinx vendor kernels that export the plain DMA channel
+     * configuration, apply the settings to the engine immediately. */
+    if (chan->type == AXIDMA_DMA) {
+        memset(&dma_config, 0, sizeof(dma_config));
+        dma_config.coalesc = coal->coalesce;
+        dma_config.delay = coal->delay;
+        rc = xilinx_dma_channel_set_config(chan->chan, &dma_config);
+        if (rc < 0) {
+            axidma_err("Unable to set the coalescing config for channel "
+                       "%d.\n", coal->channel_id);
+            axidma_put_engine(dev, chan);
+            return rc;
+        }
     }
+#endif
 
-    // Submit the transmit transfer, and wait for it to complete
-    rc = axidma_start_transfer(tx_chan, &tx_tfr);
-    if (rc < 0) {
-        return rc;
+    axidma_put_engine(dev, chan);
+    return 0;
+}
+
+/* Checks that the given channel is usable by the given client. A channel is
+ * usable if no open file has claimed it, or if this client's open file is
+ * the one that claimed it. */
+static int axidma_check_owner(struct axidma_client *client, int channel_id)
+{
+    unsigned long flags;
+    struct axidma_device *dev;
+    struct axidma_client *owner;
+
+    dev = client->dev;
+    spin_lock_irqsave(&dev->owner_lock, flags);
+    owner = dev->chan_owners[channel_id];
+    spin_unlock_irqrestore(&dev->owner_lock, flags);
+
+    if (owner != NULL && owner != client) {
+        axidma_err("Channel %d is claimed by another open file.\n",
+                   channel_id);
+        return -EBUSY;
     }
 
     return 0;
 }
 
-/* Transfers data from the given source buffer out to the AXI DMA device, and
- * places the data received into the receive buffer. */
-int axidma_rw_transfer(struct axidma_device *dev,
-                       struct axidma_inout_transaction *trans)
+int axidma_claim_channel(struct axidma_client *client, int channel_id)
 {
     int rc;
-    struct axidma_chan *tx_chan, *rx_chan;
-    struct scatterlist tx_sg_list, rx_sg_list;
-    struct axidma_transfer tx_tfr, rx_tfr;
+    unsigned long flags;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
 
-    // Get the transmit and receive channels with the given ids.
-    tx_chan = axidma_get_chan(dev, trans->tx_channel_id);
-    if (tx_chan == NULL || tx_chan->dir != AXIDMA_WRITE) {
-        axidma_err("Invalid device id %d for DMA transmit channel.\n",
-                   trans->tx_channel_id);
-        return -ENODEV;
-    }
+    dev = client->dev;
 
-    rx_chan = axidma_get_chan(dev, trans->rx_channel_id);
-    if (rx_chan == NULL || rx_chan->dir != AXIDMA_READ) {
-        axidma_err("Invalid device id %d for DMA receive channel.\n",
-                   trans->rx_channel_id);
+    // Get the channel with the given channel id
+    chan = axidma_get_chan(dev, channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for channel claim.\n", channel_id);
         return -ENODEV;
     }
 
-    // Setup the scatter-gather list for the transfers (only one entry)
-    sg_init_table(&tx_sg_list, 1);
-    rc = axidma_init_sg_entry(dev, &tx_sg_list, 0, trans->tx_buf,
-                              trans->tx_buf_len);
-    if (rc < 0) {
-        return rc;
+    /* Claim the channel for this client, unless another client holds it.
+     * Claiming a channel the client already owns is a no-op. */
+    spin_lock_irqsave(&dev->owner_lock, flags);
+    if (dev->chan_owners[channel_id] == NULL) {
+        dev->chan_owners[channel_id] = client;
+        rc = 0;
+    } else if (dev->chan_owners[channel_id] == client) {
+        rc = 0;
+    } else {
+        axidma_err("Channel %d is already claimed by another open file.\n",
+                   channel_id);
+        rc = -EBUSY;
     }
-    sg_init_table(&rx_sg_list, 1);
-    rc = axidma_init_sg_entry(dev, &rx_sg_list, 0, trans->rx_buf,
-                              trans->rx_buf_len);
-    if (rc < 0) {
+    spin_unlock_irqrestore(&dev->owner_lock, flags);
+
+    return rc;
+}
+
+/* Explicitly acquires the DMA engine backing the given channel. The engine
+ * would be acquired on first use anyway; doing it ahead of time moves the
+ * one-time cost to setup, and discovers a busy engine before the data path
+ * depends on it. */
+int axidma_acquire_channel(struct axidma_client *client, int channel_id)
+{
+    int rc;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+
+    dev = client->dev;
+
+    // Get the channel with the given channel id
+    chan = axidma_get_chan(dev, channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for channel acquire.\n", channel_id);
+        return -ENODEV;
+    }
+
+    down_read(&dev->chan_states[channel_id].engine_sem);
+    rc = axidma_engine_acquire(dev, chan);
+    up_read(&dev->chan_states[channel_id].engine_sem);
+    return rc;
+}
+
+/* Releases the DMA engine backing the given channel to the DMA subsystem,
+ * making it available to other kernel consumers. Any transfers still in
+ * flight on the channel are terminated. The channel remains valid, and is
+ * re-acquired automatically if it is used again. */
+int axidma_release_channel(struct axidma_client *client, int channel_id)
+{
+    int rc;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+
+    dev = client->dev;
+
+    // Get the channel with the given channel id
+    chan = axidma_get_chan(dev, channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for channel release.\n", channel_id);
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, channel_id);
+    if (rc < 0) {
+        return rc;
+    }
+
+    /* Take the engine semaphore exclusively, so the engine cannot be torn
+     * down while a transfer path is driving it. The release reports busy
+     * rather than waiting, since a blocking transfer can hold the semaphore
+     * shared for its full timeout. */
+    chan_state = &dev->chan_states[channel_id];
+    if (!down_write_trylock(&chan_state->engine_sem)) {
+        axidma_err("Channel %d has an operation in progress.\n", channel_id);
+        return -EBUSY;
+    }
+
+    /* Give the engine back under the acquisition lock, so a concurrent first
+     * use cannot observe the engine half torn down. A channel that was never
+     * acquired has nothing to release. */
+    mutex_lock(&dev->engine_lock);
+    if (chan->chan != NULL) {
+        dmaengine_terminate_sync(chan->chan);
+        axidma_flush_outstanding(chan_state);
+        chan_state->stream_active = false;
+        chan_state->park = false;
+        chan_state->park_frm = 0;
+        chan_state->video_frames = 0;
+        wake_up_interruptible(&chan_state->stream_wait);
+
+        dma_release_channel(chan->chan);
+        chan->chan = NULL;
+    }
+    mutex_unlock(&dev->engine_lock);
+    up_write(&chan_state->engine_sem);
+
+    return 0;
+}
+
+void axidma_release_channels(struct axidma_client *client)
+{
+    int i;
+    unsigned long flags;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+
+    // Give back every channel the client has claimed
+    dev = client->dev;
+    spin_lock_irqsave(&dev->owner_lock, flags);
+    for (i = 0; i < dev->num_chans; i++)
+    {
+        if (dev->chan_owners[i] == client) {
+            dev->chan_owners[i] = NULL;
+        }
+    }
+    spin_unlock_irqrestore(&dev->owner_lock, flags);
+
+    /* Stop any stream this client still has running, so the engine does not
+     * keep writing into a ring buffer that is about to be freed. */
+    for (i = 0; i < dev->num_chans; i++)
+    {
+        if (dev->chan_states[i].stream_active &&
+                dev->chan_states[i].stream_client == client) {
+            chan = axidma_get_chan(dev, i);
+            if (chan != NULL) {
+                dev->chan_states[i].stream_active = false;
+                down_read(&dev->chan_states[i].engine_sem);
+                if (chan->chan != NULL) {
+                    dmaengine_terminate_all(chan->chan);
+                }
+                up_read(&dev->chan_states[i].engine_sem);
+                wake_up_interruptible(&dev->chan_states[i].stream_wait);
+            }
+        }
+    }
+
+    return;
+}
+
+/* Performs a blocking transfer by busy-polling the engine's completion
+ * status from the submitting CPU, instead of sleeping until the completion
+ * callback runs. This skips the sleep/wakeup round trip, which dominates
+ * the cost of small transfers, at the price of burning the CPU while the
+ * engine works. The spin is bounded; past the budget the poll loop yields
+ * between checks, so a slow transfer cannot monopolize the CPU. */
+static int axidma_poll_transfer(struct axidma_client *client,
+        struct axidma_chan *chan, struct axidma_transaction *trans)
+{
+    int rc;
+    int spins;
+    u64 submit_ns;
+    unsigned long flags, timeout;
+    enum dma_status status;
+    dma_cookie_t dma_cookie;
+    struct dma_async_tx_descriptor *dma_txnd;
+    struct scatterlist sg_list;
+    struct axidma_chan_state *chan_state;
+    struct axidma_device *dev;
+
+    // Setup the scatter-gather list for the transfer (only one entry)
+    dev = client->dev;
+    sg_init_table(&sg_list, 1);
+    rc = axidma_init_sg_entry(client, &sg_list, 0, trans->buf, trans->buf_len,
+                              trans->buf_handle);
+    if (rc < 0) {
+        return rc;
+    }
+
+    /* Prepare and submit the transfer without a completion callback. The
+     * interrupt flag is kept, since the engine's interrupt is what advances
+     * the completion cookie that the poll loop observes; only the callback
+     * and the sleeping waiter are skipped. */
+    chan_state = &dev->chan_states[trans->channel_id];
+    dma_txnd = dmaengine_prep_slave_sg(chan->chan, &sg_list, 1,
+            axidma_to_dma_dir(chan->dir), DMA_CTRL_ACK | DMA_PREP_INTERRUPT);
+    if (dma_txnd == NULL) {
+        axidma_err("Unable to prepare the dma engine for the polled "
+                   "transfer.\n");
+        axidma_stat_failure(chan_state, false);
+        return -EBUSY;
+    }
+
+    dma_cookie = dmaengine_submit(dma_txnd);
+    if (dma_submit_error(dma_cookie)) {
+        axidma_err("Unable to submit the polled transaction to the "
+                   "engine.\n");
+        dmaengine_terminate_sync(chan->chan);
+        axidma_flush_outstanding(chan_state);
+        axidma_stat_failure(chan_state, false);
+        return -EBUSY;
+    }
+
+    submit_ns = ktime_get_ns();
+    spin_lock_irqsave(&chan_state->lock, flags);
+    chan_state->stat_submitted += 1;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    // Start the engine, and poll the transfer's status until it completes
+    dma_async_issue_pending(chan->chan);
+    timeout = jiffies + axidma_timeout_jiffies(trans->timeout_ms);
+    spins = 0;
+    while ((status = dma_async_is_tx_complete(chan->chan, dma_cookie, NULL,
+                NULL)) == DMA_IN_PROGRESS) {
+        if (time_after(jiffies, timeout)) {
+            axidma_err("Polled DMA transaction timed out.\n");
+            axidma_stat_failure(chan_state, true);
+            dmaengine_terminate_sync(chan->chan);
+            axidma_flush_outstanding(chan_state);
+            return -ETIME;
+        }
+
+        // Spin for the budget, then yield between the remaining checks
+        if (spins < AXIDMA_POLL_SPIN_LIMIT) {
+            spins += 1;
+            cpu_relax();
+        } else {
+            usleep_range(AXIDMA_POLL_SLEEP_US, 2 * AXIDMA_POLL_SLEEP_US);
+        }
+    }
+
+    if (status != DMA_COMPLETE) {
+        axidma_err("Polled DMA transaction did not succceed. Status is "
+                   "%d.\n", status);
+        axidma_stat_failure(chan_state, false);
+        dmaengine_terminate_sync(chan->chan);
+        axidma_flush_outstanding(chan_state);
+        return -EBUSY;
+    }
+
+    // Account for the completion, and record it in the completion ring
+    spin_lock_irqsave(&chan_state->lock, flags);
+    chan_state->stat_completed += 1;
+    chan_state->stat_bytes += trans->buf_len;
+    chan_state->stat_latency_ns += ktime_get_ns() - submit_ns;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+    axidma_cq_record(client, trans->channel_id, dma_cookie);
+
+    // Report the id assigned to the transfer back to the caller
+    trans->transfer_id = dma_cookie;
+    return 0;
+}
+
+int axidma_read_transfer(struct axidma_client *client,
+                         struct axidma_transaction *trans)
+{
+    int rc, sg_len;
+    struct axidma_device *dev;
+    struct axidma_chan *rx_chan;
+    struct scatterlist sg_entry, *sg_list;
+    struct axidma_transfer rx_tfr;
+
+    // Get the channel with the given channel id
+    dev = client->dev;
+    rx_chan = axidma_get_engine(dev, trans->channel_id);
+    if (rx_chan == NULL || rx_chan->dir != AXIDMA_READ) {
+        axidma_err("Invalid device id %d for DMA receive channel.\n",
+                   trans->channel_id);
+        if (rx_chan != NULL) {
+            axidma_put_engine(dev, rx_chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, trans->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, rx_chan);
+        return rc;
+    }
+
+    // Polled transfers bypass the callback machinery entirely
+    if (trans->poll && rx_chan->type == AXIDMA_DMA) {
+        rc = axidma_poll_transfer(client, rx_chan, trans);
+        axidma_put_engine(dev, rx_chan);
+        return rc;
+    }
+
+    /* Setup the scatter-gather list for the transfer. This is usually one
+     * entry; non-contiguous external buffers get one entry per segment. */
+    sg_len = axidma_build_sg_list(client, trans->buf, trans->buf_len,
+                                  trans->buf_handle, &sg_entry, &sg_list);
+    if (sg_len < 0) {
+        axidma_put_engine(dev, rx_chan);
+        return sg_len;
+    }
+
+    // Setup receive transfer structure for DMA
+    rx_tfr.sg_list = sg_list;
+    rx_tfr.sg_len = sg_len;
+    rx_tfr.dir = rx_chan->dir;
+    rx_tfr.type = rx_chan->type;
+    rx_tfr.wait = trans->wait;
+    rx_tfr.timeout_ms = trans->timeout_ms;
+    rx_tfr.channel_id = trans->channel_id;
+    rx_tfr.notify_signal = dev->notify_signal;
+    rx_tfr.process = get_current();
+    rx_tfr.client = client;
+    rx_tfr.chan_state = &dev->chan_states[trans->channel_id];
+    rx_tfr.pinned = NULL;
+
+    // Prepare the receive transfer
+    rc = axidma_prep_transfer(rx_chan, &rx_tfr);
+    if (rc < 0) {
+        goto free_sg_list;
+    }
+
+    // Submit the receive transfer, and wait for it to complete
+    rc = axidma_start_transfer(rx_chan, &rx_tfr);
+    if (rc < 0) {
+        goto free_sg_list;
+    }
+
+    // Report the id assigned to the transfer back to the caller
+    trans->transfer_id = rx_tfr.cookie;
+    rc = 0;
+
+free_sg_list:
+    if (sg_list != &sg_entry) {
+        kfree(sg_list);
+    }
+    axidma_put_engine(dev, rx_chan);
+    return rc;
+}
+
+int axidma_write_transfer(struct axidma_client *client,
+                          struct axidma_transaction *trans)
+{
+    int rc, sg_len;
+    struct axidma_device *dev;
+    struct axidma_chan *tx_chan;
+    struct scatterlist sg_entry, *sg_list;
+    struct axidma_transfer tx_tfr;
+
+    // Get the channel with the given id
+    dev = client->dev;
+    tx_chan = axidma_get_engine(dev, trans->channel_id);
+    if (tx_chan == NULL || tx_chan->dir != AXIDMA_WRITE) {
+        axidma_err("Invalid device id %d for DMA transmit channel.\n",
+                   trans->channel_id);
+        if (tx_chan != NULL) {
+            axidma_put_engine(dev, tx_chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, trans->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, tx_chan);
+        return rc;
+    }
+
+    // Polled transfers bypass the callback machinery entirely
+    if (trans->poll && tx_chan->type == AXIDMA_DMA) {
+        rc = axidma_poll_transfer(client, tx_chan, trans);
+        axidma_put_engine(dev, tx_chan);
+        return rc;
+    }
+
+    /* Setup the scatter-gather list for the transfer. This is usually one
+     * entry; non-contiguous external buffers get one entry per segment. */
+    sg_len = axidma_build_sg_list(client, trans->buf, trans->buf_len,
+                                  trans->buf_handle, &sg_entry, &sg_list);
+    if (sg_len < 0) {
+        axidma_put_engine(dev, tx_chan);
+        return sg_len;
+    }
+
+    // Setup transmit transfer structure for DMA
+    tx_tfr.sg_list = sg_list;
+    tx_tfr.sg_len = sg_len;
+    tx_tfr.dir = tx_chan->dir;
+    tx_tfr.type = tx_chan->type;
+    tx_tfr.wait = trans->wait;
+    tx_tfr.timeout_ms = trans->timeout_ms;
+    tx_tfr.channel_id = trans->channel_id;
+    tx_tfr.notify_signal = dev->notify_signal;
+    tx_tfr.process = get_current();
+    tx_tfr.client = client;
+    tx_tfr.chan_state = &dev->chan_states[trans->channel_id];
+    tx_tfr.pinned = NULL;
+
+    // Prepare the transmit transfer
+    rc = axidma_prep_transfer(tx_chan, &tx_tfr);
+    if (rc < 0) {
+        goto free_sg_list;
+    }
+
+    // Submit the transmit transfer, and wait for it to complete
+    rc = axidma_start_transfer(tx_chan, &tx_tfr);
+    if (rc < 0) {
+        goto free_sg_list;
+    }
+
+    // Report the id assigned to the transfer back to the caller
+    trans->transfer_id = tx_tfr.cookie;
+    rc = 0;
+
+free_sg_list:
+    if (sg_list != &sg_entry) {
+        kfree(sg_list);
+    }
+    axidma_put_engine(dev, tx_chan);
+    return rc;
+}
+
+/* Transfers data between the device and an arbitrary user buffer, rather
+ * than one allocated through the driver. The buffer's pages are pinned in
+ * place and mapped for streaming DMA for the duration of the transfer. */
+int axidma_user_transfer(struct axidma_client *client,
+                         struct axidma_transaction *trans,
+                         enum axidma_dir dir)
+{
+    int rc;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_pinned_buffer *pinned;
+    struct axidma_transfer tfr;
+
+    // Get the channel with the given channel id, and check its direction
+    dev = client->dev;
+    chan = axidma_get_engine(dev, trans->channel_id);
+    if (chan == NULL || chan->dir != dir || chan->type != AXIDMA_DMA) {
+        axidma_err("Invalid device id %d for DMA %s channel.\n",
+                   trans->channel_id, axidma_dir_to_string(dir));
+        if (chan != NULL) {
+            axidma_put_engine(dev, chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, trans->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // The buffer must have a non-zero length to pin any pages
+    if (trans->buf_len == 0) {
+        axidma_err("Requested a zero-length transfer at address %p.\n",
+                   trans->buf);
+        axidma_put_engine(dev, chan);
+        return -EINVAL;
+    }
+
+    // Pin the user buffer in place, and map it for DMA with the device
+    pinned = axidma_pin_user_buffer(dev, trans->buf, trans->buf_len, dir);
+    if (pinned == NULL) {
+        axidma_put_engine(dev, chan);
+        return -EFAULT;
+    }
+
+    /* Setup the transfer structure for DMA. The scatter-gather list comes
+     * from the mapped table over the pinned pages. */
+    tfr.sg_list = pinned->sg_table.sgl;
+    tfr.sg_len = pinned->sg_table.nents;
+    tfr.dir = chan->dir;
+    tfr.type = chan->type;
+    tfr.wait = trans->wait;
+    tfr.timeout_ms = trans->timeout_ms;
+    tfr.channel_id = trans->channel_id;
+    tfr.notify_signal = dev->notify_signal;
+    tfr.process = get_current();
+    tfr.client = client;
+    tfr.chan_state = &dev->chan_states[trans->channel_id];
+    tfr.pinned = pinned;
+
+    /* Prepare the transfer. On success, the pinned pages are owned by the
+     * transfer's callback data, and are released when it is retired. */
+    rc = axidma_prep_transfer(chan, &tfr);
+    if (rc < 0) {
+        axidma_unpin_user_buffer(pinned);
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // Submit the transfer, and wait for it to complete if requested
+    rc = axidma_start_transfer(chan, &tfr);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // Report the id assigned to the transfer back to the caller
+    trans->transfer_id = tfr.cookie;
+    axidma_put_engine(dev, chan);
+    return 0;
+}
+
+int axidma_batch_transfer(struct axidma_client *client,
+                          struct axidma_batch_transaction *batch)
+{
+    int rc, i, j;
+    struct axidma_device *dev;
+    unsigned long timeout, time_remain;
+    enum dma_status status;
+    struct axidma_transaction *trans;
+    struct axidma_transfer *tfrs;
+    struct scatterlist *sg_lists;
+    struct axidma_chan **chans;
+    struct axidma_chan *chan;
+
+    // The batch must have at least one transaction
+    dev = client->dev;
+    if (batch->num_trans < 1) {
+        axidma_err("Batch submission must have at least one transaction.\n");
+        return -EINVAL;
+    }
+
+    /* Allocate arrays for the transfer state. The transfer structures must
+     * stay alive until all of the completions have been waited on. */
+    tfrs = kmalloc(batch->num_trans * sizeof(*tfrs), GFP_KERNEL);
+    sg_lists = kmalloc(batch->num_trans * sizeof(*sg_lists), GFP_KERNEL);
+    chans = kzalloc(batch->num_trans * sizeof(*chans), GFP_KERNEL);
+    if (tfrs == NULL || sg_lists == NULL || chans == NULL) {
+        axidma_err("Unable to allocate memory for the batch transfers.\n");
+        rc = -ENOMEM;
+        goto free_arrays;
+    }
+
+    /* Prepare and submit every transaction to its channel, but do not start
+     * the engine yet. The direction comes from the channel itself. */
+    for (i = 0; i < batch->num_trans; i++)
+    {
+        trans = &batch->trans[i];
+        chan = axidma_get_engine(dev, trans->channel_id);
+        if (chan == NULL || chan->type != AXIDMA_DMA) {
+            axidma_err("Invalid device id %d for batch DMA transaction %d.\n",
+                       trans->channel_id, i);
+            if (chan != NULL) {
+                axidma_put_engine(dev, chan);
+            }
+            rc = -ENODEV;
+            goto stop_dma;
+        }
+        chans[i] = chan;
+
+        // Verify that the channel is not claimed by another open file
+        rc = axidma_check_owner(client, trans->channel_id);
+        if (rc < 0) {
+            goto stop_dma;
+        }
+
+        // Setup the scatter-gather list for the transaction (only one entry)
+        sg_init_table(&sg_lists[i], 1);
+        rc = axidma_init_sg_entry(client, &sg_lists[i], 0, trans->buf,
+                                  trans->buf_len, trans->buf_handle);
+        if (rc < 0) {
+            goto stop_dma;
+        }
+
+        // Setup the transfer structure for the transaction
+        tfrs[i].sg_list = &sg_lists[i];
+        tfrs[i].sg_len = 1;
+        tfrs[i].dir = chan->dir;
+        tfrs[i].type = chan->type;
+        tfrs[i].wait = batch->wait;
+        tfrs[i].timeout_ms = trans->timeout_ms;
+        tfrs[i].channel_id = trans->channel_id;
+        tfrs[i].notify_signal = dev->notify_signal;
+        tfrs[i].process = get_current();
+        tfrs[i].client = client;
+        tfrs[i].chan_state = &dev->chan_states[trans->channel_id];
+        tfrs[i].pinned = NULL;
+
+        rc = axidma_prep_transfer(chan, &tfrs[i]);
+        if (rc < 0) {
+            goto stop_dma;
+        }
+
+        // Report the id assigned to the transfer back to the caller
+        trans->transfer_id = tfrs[i].cookie;
+    }
+
+    /* Start the engine with a single issue per channel. A channel is only
+     * issued at its first occurrence in the batch. */
+    for (i = 0; i < batch->num_trans; i++)
+    {
+        for (j = 0; j < i; j++)
+        {
+            if (chans[j] == chans[i]) {
+                break;
+            }
+        }
+        if (j == i) {
+            dma_async_issue_pending(chans[i]->chan);
+        }
+    }
+
+    if (!batch->wait) {
+        rc = 0;
+        goto free_arrays;
+    }
+
+    /* Each transaction carries its own callback data and completion, so
+     * waiting on every transaction's completion waits for the whole batch. */
+    for (i = 0; i < batch->num_trans; i++)
+    {
+        timeout = axidma_timeout_jiffies(tfrs[i].timeout_ms);
+        time_remain = wait_for_completion_timeout(&tfrs[i].comp, timeout);
+        if (time_remain == 0) {
+            axidma_err("Batch DMA transaction %d timed out.\n", i);
+            rc = -ETIME;
+            goto stop_dma;
+        }
+
+        status = dma_async_is_tx_complete(chans[i]->chan, tfrs[i].cookie,
+                                          NULL, NULL);
+        if (status != DMA_COMPLETE) {
+            axidma_err("Batch DMA transaction %d did not succceed. Status is "
+                       "%d.\n", i, status);
+            rc = -EBUSY;
+            goto stop_dma;
+        }
+    }
+
+    rc = 0;
+    goto free_arrays;
+
+stop_dma:
+    // Terminate the channels of all transactions prepared so far
+    for (i = 0; i < batch->num_trans && chans[i] != NULL; i++)
+    {
+        for (j = 0; j < i; j++)
+        {
+            if (chans[j] == chans[i]) {
+                break;
+            }
+        }
+        if (j == i) {
+            dmaengine_terminate_sync(chans[i]->chan);
+            axidma_flush_outstanding(tfrs[i].chan_state);
+        }
+    }
+free_arrays:
+    /* Each successful engine lookup took the channel's engine semaphore
+     * shared, including duplicates, so each entry is put exactly once. */
+    if (chans != NULL) {
+        for (i = 0; i < batch->num_trans && chans[i] != NULL; i++)
+        {
+            axidma_put_engine(dev, chans[i]);
+        }
+    }
+    kfree(chans);
+    kfree(sg_lists);
+    kfree(tfrs);
+    return rc;
+}
+
+/* Creates a pre-prepared transfer template on the given channel. The address
+ * translation and scatter-gather construction are done once here and kept
+ * for the template's lifetime. On engines that support the descriptor reuse
+ * facility, the prepared descriptor is kept as well, so triggering the
+ * template skips descriptor preparation entirely. */
+int axidma_create_template(struct axidma_client *client,
+                           struct axidma_template *tmpl)
+{
+    int rc, i, slot, sg_len;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct scatterlist sg_entry, *sg_list, *sg_copy;
+    struct dma_slave_caps caps;
+    struct dma_async_tx_descriptor *dma_txnd;
+    struct axidma_template_entry *entry;
+
+    // Get the channel with the given channel id
+    dev = client->dev;
+    chan = axidma_get_engine(dev, tmpl->channel_id);
+    if (chan == NULL || chan->type != AXIDMA_DMA) {
+        axidma_err("Invalid device id %d for a transfer template.\n",
+                   tmpl->channel_id);
+        if (chan != NULL) {
+            axidma_put_engine(dev, chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, tmpl->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // Find a free slot in the client's template table
+    for (slot = 0; slot < AXIDMA_MAX_TEMPLATES; slot++)
+    {
+        if (client->templates[slot].chan == NULL) {
+            break;
+        }
+    }
+    if (slot == AXIDMA_MAX_TEMPLATES) {
+        axidma_err("All %d transfer templates are in use.\n",
+                   AXIDMA_MAX_TEMPLATES);
+        axidma_put_engine(dev, chan);
+        return -ENOSPC;
+    }
+    entry = &client->templates[slot];
+
+    /* Build the scatter-gather list for the buffer. The single-entry fast
+     * path serves the list from the stack, so it is copied to an allocation
+     * that lives as long as the template. */
+    sg_len = axidma_build_sg_list(client, tmpl->buf, tmpl->buf_len,
+                                  tmpl->buf_handle, &sg_entry, &sg_list);
+    if (sg_len < 0) {
+        axidma_put_engine(dev, chan);
+        return sg_len;
+    }
+    if (sg_list == &sg_entry) {
+        sg_copy = kmalloc(sizeof(*sg_copy), GFP_KERNEL);
+        if (sg_copy == NULL) {
+            axidma_err("Unable to allocate memory for the template's "
+                       "scatter-gather list.\n");
+            axidma_put_engine(dev, chan);
+            return -ENOMEM;
+        }
+        sg_init_table(sg_copy, 1);
+        sg_dma_address(&sg_copy[0]) = sg_dma_address(&sg_entry);
+        sg_dma_len(&sg_copy[0]) = sg_dma_len(&sg_entry);
+        sg_list = sg_copy;
+    }
+
+    /* If the engine supports the descriptor reuse facility, prepare the
+     * descriptor now and mark it reusable, so each trigger hands it straight
+     * back to the engine. Engines without the facility re-prepare from the
+     * cached list on each trigger, which still skips the translation and
+     * list construction above. */
+    entry->desc = NULL;
+    if (dma_get_slave_caps(chan->chan, &caps) == 0 && caps.descriptor_reuse) {
+        dma_txnd = dmaengine_prep_slave_sg(chan->chan, sg_list, sg_len,
+                axidma_to_dma_dir(chan->dir),
+                DMA_CTRL_REUSE | DMA_CTRL_ACK | DMA_PREP_INTERRUPT);
+        if (dma_txnd == NULL || dmaengine_desc_set_reuse(dma_txnd) < 0) {
+            axidma_err("Unable to prepare the template's reusable "
+                       "descriptor.\n");
+            kfree(sg_list);
+            axidma_put_engine(dev, chan);
+            return -EBUSY;
+        }
+        entry->desc = dma_txnd;
+    }
+
+    // Fill in the template entry, and report its id back to the caller
+    entry->sg_list = sg_list;
+    entry->sg_len = sg_len;
+    entry->num_bytes = 0;
+    for (i = 0; i < sg_len; i++)
+    {
+        entry->num_bytes += sg_dma_len(&sg_list[i]);
+    }
+    entry->busy = false;
+    entry->chan = chan;
+    tmpl->template_id = slot + 1;
+    axidma_put_engine(dev, chan);
+    return 0;
+}
+
+/* Triggers a transfer from a pre-prepared template, resubmitting it to its
+ * channel. With a reusable descriptor the preparation path is skipped
+ * entirely; otherwise the descriptor is re-prepared from the template's
+ * cached scatter-gather list. The transfer behaves as a normal one-shot
+ * transfer in every other respect. */
+int axidma_trigger_transfer(struct axidma_client *client,
+                            struct axidma_trigger *trigger)
+{
+    int rc;
+    unsigned long flags;
+    dma_cookie_t dma_cookie;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_cb_data *cb_data;
+    struct axidma_template_entry *entry;
+    struct axidma_chan_state *chan_state;
+    struct axidma_transfer dma_tfr;
+
+    // Look up the template with the given id
+    dev = client->dev;
+    chan = NULL;
+    entry = NULL;
+    if (trigger->template_id >= 1 &&
+            trigger->template_id <= AXIDMA_MAX_TEMPLATES) {
+        entry = &client->templates[trigger->template_id - 1];
+        chan = entry->chan;
+    }
+    if (chan == NULL) {
+        axidma_err("Requested template %d is not a live transfer "
+                   "template.\n", trigger->template_id);
+        return -ENOENT;
+    }
+
+    /* Hold the engine semaphore shared while driving the engine, as
+     * axidma_get_engine does on the normal transfer paths. The template's
+     * descriptor and list belong to the engine that prepared them, so a
+     * template does not survive its channel being released. */
+    down_read(&dev->chan_states[chan->channel_id].engine_sem);
+    if (chan->chan == NULL) {
+        axidma_err("Channel %d's engine was released; the template must be "
+                   "recreated.\n", chan->channel_id);
+        axidma_put_engine(dev, chan);
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, chan->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    /* Claim the template under the channel's lock. The busy flag keeps a
+     * reused descriptor to one submission in flight at a time, and also
+     * keeps a concurrent destroy from freeing the entry out from under this
+     * trigger. The completion callback releases the claim for reusable
+     * descriptors; the re-preparation path below releases it itself. */
+    chan_state = &dev->chan_states[chan->channel_id];
+    spin_lock_irqsave(&chan_state->lock, flags);
+    if (entry->chan == NULL) {
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+        axidma_err("Requested template %d is not a live transfer "
+                   "template.\n", trigger->template_id);
+        axidma_put_engine(dev, chan);
+        return -ENOENT;
+    }
+    if (entry->busy) {
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+        axidma_err("Template %d's descriptor is still in flight.\n",
+                   trigger->template_id);
+        axidma_put_engine(dev, chan);
+        return -EBUSY;
+    }
+    entry->busy = true;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    // Setup the transfer structure for the trigger
+    dma_tfr.sg_list = entry->sg_list;
+    dma_tfr.sg_len = entry->sg_len;
+    dma_tfr.dir = chan->dir;
+    dma_tfr.type = chan->type;
+    dma_tfr.wait = trigger->wait;
+    dma_tfr.timeout_ms = trigger->timeout_ms;
+    dma_tfr.channel_id = chan->channel_id;
+    dma_tfr.notify_signal = dev->notify_signal;
+    dma_tfr.process = get_current();
+    dma_tfr.client = client;
+    dma_tfr.chan_state = chan_state;
+    dma_tfr.pinned = NULL;
+
+    /* Without a reusable descriptor, re-prepare from the cached scatter-
+     * gather list through the normal preparation path. The claim is
+     * released once the submission is done with the cached list; the
+     * callback data built by the preparation does not reference the
+     * template. */
+    if (entry->desc == NULL) {
+        rc = axidma_prep_transfer(chan, &dma_tfr);
+        if (rc == 0) {
+            rc = axidma_start_transfer(chan, &dma_tfr);
+        }
+        spin_lock_irqsave(&chan_state->lock, flags);
+        entry->busy = false;
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+        axidma_put_engine(dev, chan);
+        if (rc < 0) {
+            return rc;
+        }
+        trigger->transfer_id = dma_tfr.cookie;
+        return 0;
+    }
+
+    /* Allocate the callback data for this trigger. The descriptor is reused
+     * across triggers, but each submission carries fresh callback data, as
+     * on the normal transfer path. */
+    cb_data = kmalloc(sizeof(*cb_data), GFP_KERNEL);
+    if (cb_data == NULL) {
+        axidma_err("Unable to allocate callback data for the trigger.\n");
+        spin_lock_irqsave(&chan_state->lock, flags);
+        entry->busy = false;
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+        axidma_put_engine(dev, chan);
+        return -ENOMEM;
+    }
+
+    /* Stamp the submission stage. The preparation was amortized when the
+     * template was created, so the prep stage collapses into the submit
+     * one, and no prep trace event fires. */
+    cb_data->num_bytes = entry->num_bytes;
+    cb_data->submit_ns = ktime_get_ns();
+    cb_data->prep_ns = cb_data->submit_ns;
+    cb_data->issue_ns = 0;
+    trace_axidma_transfer_submit(chan->channel_id, 0, cb_data->num_bytes);
+
+    cb_data->channel_id = chan->channel_id;
+    cb_data->client = client;
+    cb_data->chan_state = dma_tfr.chan_state;
+    cb_data->pinned = NULL;
+    cb_data->template_busy = &entry->busy;
+    cb_data->canceled = false;
+    dma_tfr.canceled = false;
+    if (dma_tfr.wait) {
+        cb_data->comp = &dma_tfr.comp;
+        cb_data->notify_signal = -1;
+        cb_data->process = NULL;
+        init_completion(cb_data->comp);
+    } else {
+        cb_data->comp = NULL;
+        cb_data->notify_signal = dma_tfr.notify_signal;
+        cb_data->process = dma_tfr.process;
+    }
+
+    /* The busy claim taken above keeps the reused descriptor to one
+     * submission in flight at a time, and makes its callback fields safe
+     * to rewrite below; the completion callback releases the claim under
+     * the channel's lock. */
+    spin_lock_irqsave(&dma_tfr.chan_state->lock, flags);
+    cb_data->efd_ctx = dma_tfr.chan_state->efd_ctx;
+    cb_data->efd_file = dma_tfr.chan_state->efd_file;
+    if (cb_data->efd_file != NULL) {
+        get_file(cb_data->efd_file);
+    }
+    dma_tfr.chan_state->stat_submitted += 1;
+    list_add_tail(&cb_data->list, &dma_tfr.chan_state->outstanding);
+    spin_unlock_irqrestore(&dma_tfr.chan_state->lock, flags);
+
+    // Hand the reusable descriptor back to the engine
+    entry->desc->callback = axidma_dma_callback;
+    entry->desc->callback_param = cb_data;
+    dma_cookie = dmaengine_submit(entry->desc);
+    if (dma_submit_error(dma_cookie)) {
+        axidma_err("Unable to resubmit the template's descriptor to the "
+                   "engine.\n");
+        spin_lock_irqsave(&dma_tfr.chan_state->lock, flags);
+        entry->busy = false;
+        list_del(&cb_data->list);
+        spin_unlock_irqrestore(&dma_tfr.chan_state->lock, flags);
+        axidma_stat_failure(dma_tfr.chan_state, false);
+        if (cb_data->efd_file != NULL) {
+            fput(cb_data->efd_file);
+        }
+        kfree(cb_data);
+        axidma_put_engine(dev, chan);
+        return -EBUSY;
+    }
+    dma_tfr.cookie = dma_cookie;
+    cb_data->cookie = dma_cookie;
+
+    // Submit the transfer to the engine, and wait for it to complete
+    rc = axidma_start_transfer(chan, &dma_tfr);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // Report the id assigned to the transfer back to the caller
+    trigger->transfer_id = dma_cookie;
+    axidma_put_engine(dev, chan);
+    return 0;
+}
+
+/* Destroys the transfer template with the given id, freeing its cached
+ * scatter-gather list and releasing its reusable descriptor back to the
+ * engine. If the channel's engine was already released, the descriptor went
+ * with it, and only the list remains to free. */
+int axidma_destroy_template(struct axidma_client *client, int template_id)
+{
+    unsigned long flags;
+    struct dma_async_tx_descriptor *desc;
+    struct scatterlist *sg_list;
+    struct axidma_chan *chan;
+    struct axidma_template_entry *entry;
+    struct axidma_chan_state *chan_state;
+
+    // Look up the template with the given id
+    chan = NULL;
+    entry = NULL;
+    if (template_id >= 1 && template_id <= AXIDMA_MAX_TEMPLATES) {
+        entry = &client->templates[template_id - 1];
+        chan = entry->chan;
+    }
+    if (chan == NULL) {
+        axidma_err("Requested template %d is not a live transfer "
+                   "template.\n", template_id);
+        return -ENOENT;
+    }
+
+    /* Claim the entry under the channel's lock. A template whose descriptor
+     * is still in flight is refused; otherwise the entry is emptied while
+     * the lock is held, so a concurrent trigger fails its lookup instead of
+     * resubmitting a descriptor that is being freed below. */
+    chan_state = &client->dev->chan_states[chan->channel_id];
+    spin_lock_irqsave(&chan_state->lock, flags);
+    if (entry->chan == NULL) {
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+        axidma_err("Requested template %d is not a live transfer "
+                   "template.\n", template_id);
+        return -ENOENT;
+    }
+    if (entry->busy) {
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+        axidma_err("Template %d's descriptor is still in flight.\n",
+                   template_id);
+        return -EBUSY;
+    }
+    desc = entry->desc;
+    sg_list = entry->sg_list;
+    entry->sg_list = NULL;
+    entry->desc = NULL;
+    entry->chan = NULL;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    /* Freeing the descriptor drives the engine, so the engine semaphore is
+     * held shared around it, like on the transfer paths. */
+    down_read(&chan_state->engine_sem);
+    if (desc != NULL && chan->chan != NULL) {
+        dmaengine_desc_free(desc);
+    }
+    up_read(&chan_state->engine_sem);
+    kfree(sg_list);
+    return 0;
+}
+
+/* Frees all of the client's remaining transfer templates. This is called
+ * when the file is closed, so templates the user did not destroy do not
+ * leak their lists and descriptors. */
+void axidma_free_templates(struct axidma_client *client)
+{
+    int i;
+    struct axidma_template_entry *entry;
+    struct axidma_chan_state *chan_state;
+
+    for (i = 0; i < AXIDMA_MAX_TEMPLATES; i++)
+    {
+        entry = &client->templates[i];
+        if (entry->chan == NULL) {
+            continue;
+        }
+        /* A descriptor still in flight belongs to the engine until its
+         * completion callback runs; it is reclaimed when the channel is
+         * terminated, not here. Freeing a descriptor drives the engine, so
+         * the engine semaphore is held shared around it. */
+        chan_state = &client->dev->chan_states[entry->chan->channel_id];
+        down_read(&chan_state->engine_sem);
+        if (entry->desc != NULL && !entry->busy &&
+                entry->chan->chan != NULL) {
+            dmaengine_desc_free(entry->desc);
+        }
+        up_read(&chan_state->engine_sem);
+        kfree(entry->sg_list);
+        entry->chan = NULL;
+    }
+    return;
+}
+
+int axidma_vec_transfer(struct axidma_client *client,
+                        struct axidma_transaction_vec *trans,
+                        enum axidma_dir dir)
+{
+    int rc, i;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct scatterlist *sg_list;
+    struct axidma_transfer tfr;
+
+    // Get the channel with the given channel id, and check its direction
+    dev = client->dev;
+    chan = axidma_get_engine(dev, trans->channel_id);
+    if (chan == NULL || chan->dir != dir || chan->type != AXIDMA_DMA) {
+        axidma_err("Invalid device id %d for DMA %s channel.\n",
+                   trans->channel_id, axidma_dir_to_string(dir));
+        if (chan != NULL) {
+            axidma_put_engine(dev, chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, trans->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
         return rc;
     }
 
+    // The transaction must have at least one segment
+    if (trans->icount < 1) {
+        axidma_err("Vectored transfer must have at least one segment.\n");
+        axidma_put_engine(dev, chan);
+        return -EINVAL;
+    }
+
+    // Allocate an array to store the scatter list structures for the segments
+    sg_list = kmalloc(trans->icount * sizeof(*sg_list), GFP_KERNEL);
+    if (sg_list == NULL) {
+        axidma_err("Unable to allocate memory for the scatter-gather list.\n");
+        axidma_put_engine(dev, chan);
+        return -ENOMEM;
+    }
+
+    // Setup a scatter-gather entry for each segment of the transfer
+    sg_init_table(sg_list, trans->icount);
+    for (i = 0; i < trans->icount; i++)
+    {
+        rc = axidma_init_sg_entry(client, sg_list, i, trans->iov[i].buf,
+                                  trans->iov[i].len, 0);
+        if (rc < 0) {
+            goto free_sg_list;
+        }
+    }
+
+    // Setup the transfer structure for DMA
+    tfr.sg_list = sg_list;
+    tfr.sg_len = trans->icount;
+    tfr.dir = chan->dir;
+    tfr.type = chan->type;
+    tfr.wait = trans->wait;
+    tfr.timeout_ms = 0;
+    tfr.channel_id = trans->channel_id;
+    tfr.notify_signal = dev->notify_signal;
+    tfr.process = get_current();
+    tfr.client = client;
+    tfr.chan_state = &dev->chan_states[trans->channel_id];
+    tfr.pinned = NULL;
+
+    // Prepare the transfer
+    rc = axidma_prep_transfer(chan, &tfr);
+    if (rc < 0) {
+        goto free_sg_list;
+    }
+
+    // Submit the transfer, and wait for it to complete if requested
+    rc = axidma_start_transfer(chan, &tfr);
+
+free_sg_list:
+    kfree(sg_list);
+    axidma_put_engine(dev, chan);
+    return rc;
+}
+
+/* Transfers data from the given source buffer out to the AXI DMA device, and
+ * places the data received into the receive buffer. */
+int axidma_rw_transfer(struct axidma_client *client,
+                       struct axidma_inout_transaction *trans)
+{
+    int rc;
+    struct axidma_device *dev;
+    struct axidma_chan *tx_chan, *rx_chan;
+    struct scatterlist tx_sg_list, rx_sg_list;
+    struct axidma_transfer tx_tfr, rx_tfr;
+
+    // Get the transmit and receive channels with the given ids.
+    dev = client->dev;
+    tx_chan = axidma_get_engine(dev, trans->tx_channel_id);
+    if (tx_chan == NULL || tx_chan->dir != AXIDMA_WRITE) {
+        axidma_err("Invalid device id %d for DMA transmit channel.\n",
+                   trans->tx_channel_id);
+        if (tx_chan != NULL) {
+            axidma_put_engine(dev, tx_chan);
+        }
+        return -ENODEV;
+    }
+
+    rx_chan = axidma_get_engine(dev, trans->rx_channel_id);
+    if (rx_chan == NULL || rx_chan->dir != AXIDMA_READ) {
+        axidma_err("Invalid device id %d for DMA receive channel.\n",
+                   trans->rx_channel_id);
+        if (rx_chan != NULL) {
+            axidma_put_engine(dev, rx_chan);
+        }
+        rc = -ENODEV;
+        goto put_tx_engine;
+    }
+
+    // Verify that neither channel is claimed by another open file
+    rc = axidma_check_owner(client, trans->tx_channel_id);
+    if (rc < 0) {
+        goto put_engines;
+    }
+    rc = axidma_check_owner(client, trans->rx_channel_id);
+    if (rc < 0) {
+        goto put_engines;
+    }
+
+    // Setup the scatter-gather list for the transfers (only one entry)
+    sg_init_table(&tx_sg_list, 1);
+    rc = axidma_init_sg_entry(client, &tx_sg_list, 0, trans->tx_buf,
+                              trans->tx_buf_len, 0);
+    if (rc < 0) {
+        goto put_engines;
+    }
+    sg_init_table(&rx_sg_list, 1);
+    rc = axidma_init_sg_entry(client, &rx_sg_list, 0, trans->rx_buf,
+                              trans->rx_buf_len, 0);
+    if (rc < 0) {
+        goto put_engines;
+    }
+
     // Setup receive and trasmit transfer structures for DMA
     tx_tfr.sg_list = &tx_sg_list,
     tx_tfr.sg_len = 1,
     tx_tfr.dir = tx_chan->dir,
     tx_tfr.type = tx_chan->type,
     tx_tfr.wait = false,
+    tx_tfr.timeout_ms = 0,
     tx_tfr.channel_id = trans->tx_channel_id,
     tx_tfr.notify_signal = dev->notify_signal,
     tx_tfr.process = get_current(),
-    tx_tfr.cb_data = &dev->cb_data[trans->tx_channel_id];
+    tx_tfr.client = client,
+    tx_tfr.chan_state = &dev->chan_states[trans->tx_channel_id];
+    tx_tfr.pinned = NULL;
 
     // Add in the frame information for VDMA transfers
     if (tx_chan->type == AXIDMA_VDMA) {
@@ -512,10 +2360,13 @@ int axidma_rw_transfer(struct axidma_device *dev,
     rx_tfr.dir = rx_chan->dir,
     rx_tfr.type = rx_chan->type,
     rx_tfr.wait = trans->wait,
+    rx_tfr.timeout_ms = 0,
     rx_tfr.channel_id = trans->rx_channel_id,
     rx_tfr.notify_signal = dev->notify_signal,
     rx_tfr.process = get_current(),
-    rx_tfr.cb_data = &dev->cb_data[trans->rx_channel_id];
+    rx_tfr.client = client,
+    rx_tfr.chan_state = &dev->chan_states[trans->rx_channel_id];
+    rx_tfr.pinned = NULL;
 
     // Add in the frame information for VDMA transfers
     if (tx_chan->type == AXIDMA_VDMA) {
@@ -525,32 +2376,34 @@ int axidma_rw_transfer(struct axidma_device *dev,
     // Prep both the receive and transmit transfers
     rc = axidma_prep_transfer(tx_chan, &tx_tfr);
     if (rc < 0) {
-        return rc;
+        goto put_engines;
     }
     rc = axidma_prep_transfer(rx_chan, &rx_tfr);
     if (rc < 0) {
-        return rc;
+        goto put_engines;
     }
 
     // Submit both transfers to the DMA engine, and wait on the receive transfer
     rc = axidma_start_transfer(tx_chan, &tx_tfr);
     if (rc < 0) {
-        return rc;
+        goto put_engines;
     }
     rc = axidma_start_transfer(rx_chan, &rx_tfr);
-    if (rc < 0) {
-        return rc;
-    }
 
-    return 0;
+put_engines:
+    axidma_put_engine(dev, rx_chan);
+put_tx_engine:
+    axidma_put_engine(dev, tx_chan);
+    return rc;
 }
 
-int axidma_video_transfer(struct axidma_device *dev,
+int axidma_video_transfer(struct axidma_client *client,
                           struct axidma_video_transaction *trans,
                           enum axidma_dir dir)
 {
     int rc, i;
     size_t image_size;
+    struct axidma_device *dev = client->dev;
     struct axidma_chan *chan;
     struct scatterlist *sg_list;
 
@@ -563,6 +2416,7 @@ int axidma_video_transfer(struct axidma_device *dev,
         .channel_id = trans->channel_id,
         .notify_signal = dev->notify_signal,
         .process = get_current(),
+        .client = client,
         .frame = trans->frame,
     };
 
@@ -578,45 +2432,199 @@ int axidma_video_transfer(struct axidma_device *dev,
     image_size = trans->frame.width * trans->frame.height * trans->frame.depth;
     for (i = 0; i < transfer.sg_len; i++)
     {
-        rc = axidma_init_sg_entry(dev, transfer.sg_list, i,
-                                  trans->frame_buffers[i], image_size);
+        rc = axidma_init_sg_entry(client, transfer.sg_list, i,
+                                  trans->frame_buffers[i], image_size, 0);
         if (rc < 0) {
             goto free_sg_list;
         }
     }
 
     // Get the channel with the given id
-    chan = axidma_get_chan(dev, trans->channel_id);
-    if (chan == NULL && chan->dir != dir &&
+    chan = axidma_get_engine(dev, trans->channel_id);
+    if (chan == NULL || chan->dir != dir ||
             chan->type != AXIDMA_VDMA) {
         axidma_err("Invalid device id %d for VDMA %s channel.\n",
-                   trans->channel_id, axidma_dir_to_string(chan->dir));
+                   trans->channel_id, axidma_dir_to_string(dir));
+        if (chan != NULL) {
+            axidma_put_engine(dev, chan);
+        }
         rc = -ENODEV;
         goto free_sg_list;
     }
-    transfer.cb_data = &dev->cb_data[trans->channel_id];
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, trans->channel_id);
+    if (rc < 0) {
+        goto put_engine;
+    }
+    transfer.chan_state = &dev->chan_states[trans->channel_id];
+
+    /* A new video transfer starts out circulating through all of its frame
+     * buffers; the frame count bounds later AXIDMA_VIDEO_SET_FRAME calls. */
+    transfer.chan_state->park = false;
+    transfer.chan_state->park_frm = 0;
+    transfer.chan_state->video_frames = trans->num_frame_buffers;
 
     // Prepare the transmit transfer
     rc = axidma_prep_transfer(chan, &transfer);
     if (rc < 0) {
-        goto free_sg_list;
+        goto put_engine;
     }
 
     // Submit the transfer, and immediately return
     rc = axidma_start_transfer(chan, &transfer);
 
+put_engine:
+    axidma_put_engine(dev, chan);
 free_sg_list:
     kfree(transfer.sg_list);
 ret:
+    return rc;
+}
+
+/* Switches the frame buffer a running VDMA transfer scans out, by parking
+ * the engine on the selected frame. The park is applied to the live channel
+ * configuration and takes effect at the next frame boundary, so the switch
+ * is tear-free and the display is never blanked, unlike a stop/start cycle
+ * of the transfer. A negative frame index releases the park, resuming
+ * circulation through all of the transfer's frame buffers. */
+int axidma_video_set_frame(struct axidma_client *client,
+                           struct axidma_frame_sel *sel)
+{
+    int rc;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+    struct xilinx_vdma_config vdma_config;
+
+    // Get the channel with the given channel id, which must be VDMA
+    dev = client->dev;
+    chan = axidma_get_engine(dev, sel->channel_id);
+    if (chan == NULL || chan->type != AXIDMA_VDMA) {
+        axidma_err("Invalid device id %d for VDMA frame selection.\n",
+                   sel->channel_id);
+        if (chan != NULL) {
+            axidma_put_engine(dev, chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, sel->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // A video transfer must be running, and the frame must be part of it
+    chan_state = &dev->chan_states[sel->channel_id];
+    if (chan_state->video_frames == 0) {
+        axidma_err("No video transfer is running on channel %d.\n",
+                   sel->channel_id);
+        axidma_put_engine(dev, chan);
+        return -EBUSY;
+    }
+    if (sel->frame_index >= chan_state->video_frames) {
+        axidma_err("Frame index %d is out of range for a video transfer "
+                   "with %d frame buffers.\n", sel->frame_index,
+                   chan_state->video_frames);
+        axidma_put_engine(dev, chan);
+        return -EINVAL;
+    }
+
+    /* Record the park state, and apply it to the running channel. The
+     * engine finishes the frame it is currently processing before the park
+     * takes hold, so the switch happens at a frame boundary. */
+    chan_state->park = (sel->frame_index >= 0);
+    chan_state->park_frm = (sel->frame_index >= 0) ? sel->frame_index : 0;
+    axidma_setup_vdma_config(&vdma_config, chan_state);
+    rc = xilinx_vdma_channel_set_config(chan->chan, &vdma_config);
+    if (rc < 0) {
+        axidma_err("Unable to set the park config for channel %d.\n",
+                   sel->channel_id);
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    axidma_put_engine(dev, chan);
     return 0;
 }
 
-int axidma_stop_channel(struct axidma_device *dev,
+/* Cancels a single in-flight transfer, leaving the rest of the channel's
+ * queue undisturbed. The DMA engine cannot abort one descriptor in place --
+ * terminating a channel kills everything queued on it -- so the transfer is
+ * detached instead: a thread blocked waiting on it is released immediately,
+ * and its eventual completion is retired silently rather than being
+ * reported. The engine keeps working on the descriptor until it completes
+ * or the channel is terminated. */
+int axidma_cancel_transfer(struct axidma_client *client,
+                           struct axidma_cancel *cancel)
+{
+    int rc;
+    unsigned long flags;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+    struct axidma_cb_data *cb_data;
+    struct axidma_transfer *tfr;
+
+    // Get the channel with the given channel id
+    dev = client->dev;
+    chan = axidma_get_chan(dev, cancel->channel_id);
+    if (chan == NULL) {
+        axidma_err("Invalid device id %d for the cancel request.\n",
+                   cancel->channel_id);
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, cancel->channel_id);
+    if (rc < 0) {
+        return rc;
+    }
+
+    /* Find the transfer on the channel's outstanding list. A transfer that
+     * has already completed, or was never submitted, is not on the list. */
+    rc = -ENOENT;
+    chan_state = &dev->chan_states[cancel->channel_id];
+    spin_lock_irqsave(&chan_state->lock, flags);
+    list_for_each_entry(cb_data, &chan_state->outstanding, list)
+    {
+        if (cb_data->cookie != cancel->transfer_id) {
+            continue;
+        }
+
+        /* Mark the transfer as canceled, so its completion callback retires
+         * it without reporting it. If a thread is blocked waiting on the
+         * transfer, release it now; the completion is embedded in the
+         * waiter's transfer structure, which stays alive until the waiter
+         * returns, and the waiter cannot return before this lock is
+         * dropped. The completion pointer is cleared so the callback can
+         * never signal it after the waiter's stack frame is gone. */
+        cb_data->canceled = true;
+        if (cb_data->comp != NULL) {
+            tfr = container_of(cb_data->comp, struct axidma_transfer, comp);
+            tfr->canceled = true;
+            complete(cb_data->comp);
+            cb_data->comp = NULL;
+        }
+        rc = 0;
+        break;
+    }
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    return rc;
+}
+
+int axidma_stop_channel(struct axidma_client *client,
                         struct axidma_chan *chan_info)
 {
+    int rc;
+    struct axidma_device *dev;
     struct axidma_chan *chan;
 
     // Get the transmit and receive channels with the given ids.
+    dev = client->dev;
     chan = axidma_get_chan(dev, chan_info->channel_id);
     if (chan == NULL && chan->type != chan_info->type &&
             chan->dir != chan_info->dir) {
@@ -626,49 +2634,309 @@ int axidma_stop_channel(struct axidma_device *dev,
         return -ENODEV;
     }
 
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, chan_info->channel_id);
+    if (rc < 0) {
+        return rc;
+    }
+
+    /* If the channel's engine was never acquired, there is nothing to stop.
+     * The engine semaphore is held shared across the terminate, so the
+     * engine cannot be released underneath it. */
+    down_read(&dev->chan_states[chan_info->channel_id].engine_sem);
+    if (chan->chan == NULL) {
+        up_read(&dev->chan_states[chan_info->channel_id].engine_sem);
+        return 0;
+    }
+
     // Terminate all DMA transactions on the given channel
-    return dmaengine_terminate_all(chan->chan);
+    rc = dmaengine_terminate_sync(chan->chan);
+    axidma_flush_outstanding(&dev->chan_states[chan_info->channel_id]);
+
+    // Any running video transfer is gone, so clear the VDMA park state
+    dev->chan_states[chan_info->channel_id].park = false;
+    dev->chan_states[chan_info->channel_id].park_frm = 0;
+    dev->chan_states[chan_info->channel_id].video_frames = 0;
+    up_read(&dev->chan_states[chan_info->channel_id].engine_sem);
+    return rc;
 }
 
-/*----------------------------------------------------------------------------
- * Initialization and Cleanup
- *----------------------------------------------------------------------------*/
+/* Starts a cyclic streaming transfer on a DMA channel. The ring buffer is
+ * cut into equally sized slots, and the engine services them continuously
+ * with no gap between the last slot and the first. */
+int axidma_stream_start(struct axidma_client *client,
+                        struct axidma_stream *stream)
+{
+    int rc;
+    size_t period_len;
+    dma_addr_t dma_addr;
+    dma_cookie_t dma_cookie;
+    unsigned long flags;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+    struct dma_async_tx_descriptor *dma_txnd;
+
+    // Get the channel with the given channel id, which must be a DMA channel
+    dev = client->dev;
+    chan = axidma_get_engine(dev, stream->channel_id);
+    if (chan == NULL || chan->type != AXIDMA_DMA) {
+        axidma_err("Invalid device id %d for DMA streaming channel.\n",
+                   stream->channel_id);
+        if (chan != NULL) {
+            axidma_put_engine(dev, chan);
+        }
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, stream->channel_id);
+    if (rc < 0) {
+        axidma_put_engine(dev, chan);
+        return rc;
+    }
+
+    // The ring must cut evenly into at least two slots
+    if (stream->num_periods < 2 || stream->buf_len == 0 ||
+            stream->buf_len % stream->num_periods != 0) {
+        axidma_err("Stream ring of %zu bytes does not cut evenly into %d "
+                   "slots.\n", stream->buf_len, stream->num_periods);
+        axidma_put_engine(dev, chan);
+        return -EINVAL;
+    }
+    period_len = stream->buf_len / stream->num_periods;
+
+    // Only one stream can be active on a channel at a time
+    chan_state = &dev->chan_states[stream->channel_id];
+    if (chan_state->stream_active) {
+        axidma_err("Channel %d already has an active stream.\n",
+                   stream->channel_id);
+        axidma_put_engine(dev, chan);
+        return -EBUSY;
+    }
+
+    // Translate the ring buffer's user virtual address to a DMA address
+    dma_addr = axidma_uservirt_to_dma(client, stream->buf, stream->buf_len);
+    if (dma_addr == (dma_addr_t)NULL) {
+        axidma_err("Requested stream ring address %p does not fall within a "
+                   "previously allocated DMA buffer.\n", stream->buf);
+        axidma_put_engine(dev, chan);
+        return -EFAULT;
+    }
+
+    // Prepare the cyclic transfer over the ring buffer
+    dma_txnd = dmaengine_prep_dma_cyclic(chan->chan, dma_addr,
+            stream->buf_len, period_len, axidma_to_dma_dir(chan->dir),
+            DMA_PREP_INTERRUPT);
+    if (dma_txnd == NULL) {
+        axidma_err("Unable to prepare the cyclic transfer for channel %d.\n",
+                   stream->channel_id);
+        axidma_put_engine(dev, chan);
+        return -EBUSY;
+    }
+
+    /* Reset the stream indices before submission, since the engine starts
+     * invoking the per-slot callback as soon as it is issued. The channel
+     * state array outlives every stream, so it is safe as callback data. */
+    spin_lock_irqsave(&chan_state->lock, flags);
+    chan_state->stream_periods = stream->num_periods;
+    chan_state->stream_head = 0;
+    chan_state->stream_tail = 0;
+    chan_state->stream_client = client;
+    chan_state->stream_active = true;
+    spin_unlock_irqrestore(&chan_state->lock, flags);
+
+    dma_txnd->callback = axidma_stream_callback;
+    dma_txnd->callback_param = chan_state;
+
+    dma_cookie = dmaengine_submit(dma_txnd);
+    if (dma_submit_error(dma_cookie)) {
+        axidma_err("Unable to submit the cyclic transaction to the "
+                   "engine.\n");
+        chan_state->stream_active = false;
+        dmaengine_terminate_all(chan->chan);
+        axidma_put_engine(dev, chan);
+        return -EBUSY;
+    }
+
+    // Start the engine; it now runs until the stream is stopped
+    dma_async_issue_pending(chan->chan);
+    axidma_put_engine(dev, chan);
+    return 0;
+}
 
-static int axidma_request_channels(struct platform_device *pdev,
-                                   struct axidma_device *dev)
+/* Consumes the next filled slot of a cyclic stream. If user space has fallen
+ * a full ring behind the engine, the overwritten slots are skipped and
+ * reported in the dropped count, so consumption resumes with valid data. */
+int axidma_stream_next(struct axidma_client *client,
+                       struct axidma_stream_slot *slot)
 {
-    int rc, i;
-    int num_reserved_chans;
+    int rc;
+    u64 lost;
+    unsigned long flags;
+    struct axidma_device *dev;
     struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+
+    // Get the channel with the given channel id, which must be a DMA channel
+    dev = client->dev;
+    chan = axidma_get_chan(dev, slot->channel_id);
+    if (chan == NULL || chan->type != AXIDMA_DMA) {
+        axidma_err("Invalid device id %d for DMA streaming channel.\n",
+                   slot->channel_id);
+        return -ENODEV;
+    }
 
-    // For each channel, request exclusive access to the channel
-    num_reserved_chans = 0;
-    for (i = 0; i < dev->num_chans; i++)
-    {
-        chan = &dev->channels[i];
-        chan->chan = dma_request_slave_channel(&pdev->dev, chan->name);
-        if (chan->chan == NULL) {
-            axidma_err("Unable to get slave channel %d: %s.\n", i, chan->name);
-            rc = -ENODEV;
-            goto release_channels;
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, slot->channel_id);
+    if (rc < 0) {
+        return rc;
+    }
+
+    // The channel must have an active stream to consume slots from
+    chan_state = &dev->chan_states[slot->channel_id];
+    if (!chan_state->stream_active) {
+        axidma_err("Channel %d does not have an active stream.\n",
+                   slot->channel_id);
+        return -EINVAL;
+    }
+
+    /* For a blocking call, wait until the engine fills a slot, or the stream
+     * is stopped out from under us. */
+    if (slot->wait) {
+        rc = wait_event_interruptible(chan_state->stream_wait,
+                chan_state->stream_head != chan_state->stream_tail ||
+                !chan_state->stream_active);
+        if (rc < 0) {
+            return rc;
+        } else if (!chan_state->stream_active) {
+            return -EINVAL;
+        }
+    }
+
+    // Consume the oldest filled slot, skipping any overwritten ones
+    spin_lock_irqsave(&chan_state->lock, flags);
+    slot->dropped = 0;
+    if (chan_state->stream_head == chan_state->stream_tail) {
+        slot->slot = -1;
+    } else {
+        lost = chan_state->stream_head - chan_state->stream_tail;
+        if (lost > (u64)chan_state->stream_periods) {
+            slot->dropped = lost - chan_state->stream_periods;
+            chan_state->stream_tail += slot->dropped;
         }
-        num_reserved_chans += 1;
+        slot->slot = chan_state->stream_tail % chan_state->stream_periods;
+        chan_state->stream_tail += 1;
     }
+    spin_unlock_irqrestore(&chan_state->lock, flags);
 
     return 0;
+}
 
-release_channels:
-    // Release any channels that have been requested already so far
-    for (i = 0; i < num_reserved_chans; i++)
-    {
-        dma_release_channel(dev->channels[i].chan);
+/* Stops the cyclic stream on the given channel, and wakes up any blocked
+ * consumers so they can observe that the stream has ended. */
+int axidma_stream_stop(struct axidma_client *client, int channel_id)
+{
+    int rc;
+    struct axidma_device *dev;
+    struct axidma_chan *chan;
+    struct axidma_chan_state *chan_state;
+
+    // Get the channel with the given channel id, which must be a DMA channel
+    dev = client->dev;
+    chan = axidma_get_chan(dev, channel_id);
+    if (chan == NULL || chan->type != AXIDMA_DMA) {
+        axidma_err("Invalid device id %d for DMA streaming channel.\n",
+                   channel_id);
+        return -ENODEV;
+    }
+
+    // Verify that the channel is not claimed by another open file
+    rc = axidma_check_owner(client, channel_id);
+    if (rc < 0) {
+        return rc;
+    }
+
+    // The channel must have an active stream to stop
+    chan_state = &dev->chan_states[channel_id];
+    if (!chan_state->stream_active) {
+        axidma_err("Channel %d does not have an active stream.\n",
+                   channel_id);
+        return -EINVAL;
     }
+
+    /* Terminate the cyclic transfer, and release any blocked consumers. The
+     * engine is re-checked under the engine semaphore, since a concurrent
+     * channel release tears the stream down itself. */
+    chan_state->stream_active = false;
+    rc = 0;
+    down_read(&chan_state->engine_sem);
+    if (chan->chan != NULL) {
+        rc = dmaengine_terminate_all(chan->chan);
+    }
+    up_read(&chan_state->engine_sem);
+    wake_up_interruptible(&chan_state->stream_wait);
     return rc;
 }
 
+/*----------------------------------------------------------------------------
+ * Debugfs Statistics
+ *----------------------------------------------------------------------------*/
+
+/* Prints the statistics of every channel, one per line, mirroring the
+ * counters exposed through AXIDMA_GET_CHANNEL_STATS. */
+static int axidma_stats_show(struct seq_file *file, void *data)
+{
+    int i;
+    unsigned long flags;
+    struct axidma_device *dev;
+    struct axidma_chan_stats stats;
+    struct axidma_chan_state *chan_state;
+
+    dev = file->private;
+    seq_printf(file, "channel submitted completed bytes errors timeouts "
+               "latency_ns\n");
+    for (i = 0; i < dev->num_chans; i++)
+    {
+        chan_state = &dev->chan_states[i];
+        spin_lock_irqsave(&chan_state->lock, flags);
+        stats.submitted = chan_state->stat_submitted;
+        stats.completed = chan_state->stat_completed;
+        stats.bytes = chan_state->stat_bytes;
+        stats.errors = chan_state->stat_errors;
+        stats.timeouts = chan_state->stat_timeouts;
+        stats.latency_ns = chan_state->stat_latency_ns;
+        spin_unlock_irqrestore(&chan_state->lock, flags);
+
+        seq_printf(file, "%d %llu %llu %llu %llu %llu %llu\n",
+                   dev->channels[i].channel_id, stats.submitted,
+                   stats.completed, stats.bytes, stats.errors, stats.timeouts,
+                   stats.latency_ns);
+    }
+
+    return 0;
+}
+
+static int axidma_stats_open(struct inode *inode, struct file *file)
+{
+    return single_open(file, axidma_stats_show, inode->i_private);
+}
+
+static const struct file_operations axidma_stats_fops = {
+    .owner = THIS_MODULE,
+    .open = axidma_stats_open,
+    .read = seq_read,
+    .llseek = seq_lseek,
+    .release = single_release,
+};
+
+/*----------------------------------------------------------------------------
+ * Initialization and Cleanup
+ *----------------------------------------------------------------------------*/
+
 int axidma_dma_init(struct platform_device *pdev, struct axidma_device *dev)
 {
-    int rc;
+    int rc, i;
     size_t elem_size;
     u64 dma_mask;
 
@@ -693,25 +2961,73 @@ int axidma_dma_init(struct platform_device *pdev, struct axidma_device *dev)
         return -ENOMEM;
     }
 
-    // Allocate an array to store all callback structures, for async
-    elem_size = sizeof(dev->cb_data[0]);
-    dev->cb_data = kmalloc(dev->num_chans * elem_size, GFP_KERNEL);
-    if (dev->cb_data == NULL) {
-        axidma_err("Unable to allocate memory for callback structures.\n");
+    /* Allocate an array to store the per-channel transfer state. The array
+     * is zeroed so that no channel starts with an eventfd registered. */
+    elem_size = sizeof(dev->chan_states[0]);
+    dev->chan_states = kzalloc(dev->num_chans * elem_size, GFP_KERNEL);
+    if (dev->chan_states == NULL) {
+        axidma_err("Unable to allocate memory for channel state.\n");
         rc = -ENOMEM;
         goto free_channels;
     }
+    for (i = 0; i < dev->num_chans; i++)
+    {
+        spin_lock_init(&dev->chan_states[i].lock);
+        INIT_LIST_HEAD(&dev->chan_states[i].outstanding);
+        init_rwsem(&dev->chan_states[i].engine_sem);
+        init_waitqueue_head(&dev->chan_states[i].stream_wait);
+        dev->chan_states[i].coalesce = 1;
+        dev->chan_states[i].delay = 0;
+    }
+
+    /* Allocate the channel owner array, used to track which open file, if
+     * any, has claimed each channel for its exclusive use. */
+    spin_lock_init(&dev->owner_lock);
+    elem_size = sizeof(dev->chan_owners[0]);
+    dev->chan_owners = kzalloc(dev->num_chans * elem_size, GFP_KERNEL);
+    if (dev->chan_owners == NULL) {
+        axidma_err("Unable to allocate memory for channel owners.\n");
+        rc = -ENOMEM;
+        goto free_chan_states;
+    }
 
     // Parse the type and direction of each DMA channel from the device tree
     rc = axidma_of_parse_dma_nodes(pdev, dev);
     if (rc < 0) {
-        return rc;
+        goto free_chan_owners;
     }
 
-    // Exclusively request all of the channels in the device tree entry
-    rc = axidma_request_channels(pdev, dev);
-    if (rc < 0) {
-        goto free_callback_data;
+    /* Build the channel lookup table, indexed by channel id. The ids were
+     * validated during parsing, so lookups on the transfer paths become a
+     * single bounds-checked table index. */
+    elem_size = sizeof(dev->chan_index[0]);
+    dev->chan_index = kzalloc(dev->num_chans * elem_size, GFP_KERNEL);
+    if (dev->chan_index == NULL) {
+        axidma_err("Unable to allocate memory for the channel index.\n");
+        rc = -ENOMEM;
+        goto free_chan_owners;
+    }
+    for (i = 0; i < dev->num_chans; i++)
+    {
+        dev->chan_index[dev->channels[i].channel_id] = &dev->channels[i];
+    }
+
+    /* The DMA engines are acquired lazily on first use rather than here, so
+     * probing only registers the channels' metadata. Unused engines never
+     * get tied up, and a busy engine fails its first use instead of failing
+     * the whole module load. */
+    mutex_init(&dev->engine_lock);
+    for (i = 0; i < dev->num_chans; i++)
+    {
+        dev->channels[i].chan = NULL;
+    }
+
+    /* Expose the per-channel statistics through debugfs. Debugfs failures
+     * are not fatal, since the counters remain available via ioctl. */
+    dev->debugfs_dir = debugfs_create_dir(MODULE_NAME, NULL);
+    if (!IS_ERR_OR_NULL(dev->debugfs_dir)) {
+        debugfs_create_file("stats", 0444, dev->debugfs_dir, dev,
+                            &axidma_stats_fops);
     }
 
     axidma_info("DMA: Found %d transmit channels and %d receive channels.\n",
@@ -720,8 +3036,10 @@ int axidma_dma_init(struct platform_device *pdev, struct axidma_device *dev)
                 dev->num_vdma_tx_chans, dev->num_vdma_rx_chans);
     return 0;
 
-free_callback_data:
-    kfree(dev->cb_data);
+free_chan_owners:
+    kfree(dev->chan_owners);
+free_chan_states:
+    kfree(dev->chan_states);
 free_channels:
     kfree(dev->channels);
     return rc;
@@ -732,17 +3050,35 @@ void axidma_dma_exit(struct axidma_device *dev)
     int i;
     struct dma_chan *chan;
 
-    // Stop all running DMA transactions on all channels, and release
+    // Remove the debugfs statistics entries
+    if (!IS_ERR_OR_NULL(dev->debugfs_dir)) {
+        debugfs_remove_recursive(dev->debugfs_dir);
+    }
+
+    /* Stop all running DMA transactions on all channels, and release the
+     * engines. Channels whose engine was never acquired have nothing to
+     * stop or release. */
     for (i = 0; i < dev->num_chans; i++)
     {
         chan = dev->channels[i].chan;
-        dmaengine_terminate_all(chan);
-        dma_release_channel(chan);
+        if (chan != NULL) {
+            dmaengine_terminate_sync(chan);
+            axidma_flush_outstanding(&dev->chan_states[i]);
+            dma_release_channel(chan);
+        }
+
+        // Release the channel's eventfd if one is still registered
+        if (dev->chan_states[i].efd_ctx != NULL) {
+            eventfd_ctx_put(dev->chan_states[i].efd_ctx);
+            fput(dev->chan_states[i].efd_file);
+        }
     }
 
-    // Free the channel and callback data arrays
+    // Free the channel, channel index, state, and owner arrays
     kfree(dev->channels);
-    kfree(dev->cb_data);
+    kfree(dev->chan_index);
+    kfree(dev->chan_states);
+    kfree(dev->chan_owners);
 
     return;
 }
@@ -12,6 +12,7 @@
 
 // Kernel Dependencies
 #include <linux/of.h>               // Device tree parsing functions
+#include <linux/of_address.h>       // Device tree address parsing functions
 #include <linux/platform_device.h>  // Platform device definitions
 
 // Local Dependencies
@@ -132,10 +133,19 @@ static int axidma_check_unique_ids(struct axidma_device *dev)
     int i, j;
     struct axidma_chan *chan1, *chan2;
 
-    // For each channel, check that its ID does not match any other channel's
+    /* For each channel, check that its ID does not match any other channel's.
+     * The ids must also be less than the number of channels, since the
+     * per-channel state arrays and the channel lookup table are indexed by
+     * the channel id directly. */
     for (i = 0; i < dev->num_chans; i++)
     {
         chan1 = &dev->channels[i];
+        if (chan1->channel_id < 0 || chan1->channel_id >= dev->num_chans) {
+            axidma_err("Channel %d in the 'dmas' list has id %d, which is "
+                       "out of range for %d channels.\n", i,
+                       chan1->channel_id, dev->num_chans);
+            return -EINVAL;
+        }
         for (j = i+1; j < dev->num_chans; j++)
         {
             chan2 = &dev->channels[j];
@@ -260,3 +270,37 @@ int axidma_of_parse_dma_nodes(struct platform_device *pdev,
     // Check that all channels have unique channel ID's
     return axidma_check_unique_ids(dev);
 }
+
+/* Parses the optional 'memory-region' property of the driver's device tree
+ * node, which names a reserved-memory node that the driver uses as its DMA
+ * buffer pool. A missing property is not an error, since the pool is
+ * optional; the physical base and size are left at zero in that case. */
+int axidma_of_parse_reserved_mem(struct platform_device *pdev,
+                                 struct axidma_device *dev)
+{
+    int rc;
+    struct resource res;
+    struct device_node *mem_node;
+
+    dev->pool_phys = 0;
+    dev->pool_size = 0;
+
+    // The reserved pool is optional, so a missing property is not an error
+    mem_node = of_parse_phandle(pdev->dev.of_node, "memory-region", 0);
+    if (mem_node == NULL) {
+        return 0;
+    }
+
+    // Read the physical base address and size of the reserved region
+    rc = of_address_to_resource(mem_node, 0, &res);
+    of_node_put(mem_node);
+    if (rc < 0) {
+        axidma_node_err(pdev->dev.of_node, "Unable to read the address of "
+                        "the 'memory-region' reserved-memory node.\n");
+        return rc;
+    }
+
+    dev->pool_phys = res.start;
+    dev->pool_size = resource_size(&res);
+    return 0;
+}
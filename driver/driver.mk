@@ -30,6 +30,9 @@ endif
 ifneq ($(origin XILINX_DMA_INCLUDE_PATH_FIXUP),undefined)
     export XILINX_DMA_INCLUDE_PATH_FIXUP
 endif
+ifneq ($(origin XILINX_DMA_HAS_DMA_CONFIG),undefined)
+    export XILINX_DMA_HAS_DMA_CONFIG
+endif
 
 # When natively compiling, we can infer the kernel's source tree directory,
 # if the user has not specified it.
@@ -15,12 +15,15 @@
  * the a given number of times to calculate the performance statistics. All of
  * these options are configurable from the command line.
  *
- * NOTE: This program assumes that there are only two DMA channels being used by
- * the PL fabric, one that consumes data and sends it to the PL fabric logic,
- * and another that sends the output of the PL fabric back to memory. If you
- * have additional DMA channels, you will need to modify the program. This
- * program will work with the AXI DMA/VDMA loopback examples (where the S2MM and
- * MM2S ports are simply connected to one another).
+ * By default the program drives a single pair of DMA channels, one that
+ * consumes data and sends it to the PL fabric logic, and another that sends
+ * the output of the PL fabric back to memory. The -m option instead drives
+ * every available tx/rx channel pair concurrently, one thread per pair, to
+ * characterize the aggregate behavior of the fabric and the driver. The -w
+ * option sweeps a geometric series of transfer sizes in one invocation and
+ * prints a size-vs-throughput table. This program will work with the AXI
+ * DMA/VDMA loopback examples (where the S2MM and MM2S ports are simply
+ * connected to one another).
  *
  * @bug No known bugs.
  **/
@@ -37,8 +40,10 @@
 #include <sys/ioctl.h>          // IOCTL system call
 #include <unistd.h>             // Close() system call
 #include <sys/time.h>           // Timing functions and definitions
+#include <time.h>               // Clock_gettime and timespec definitions
 #include <getopt.h>             // Option parsing
 #include <errno.h>              // Error codes
+#include <pthread.h>            // Threads for the multi-channel mode
 
 #include "libaxidma.h"          // Interface to the AXI DMA
 #include "util.h"               // Miscellaneous utilities
@@ -55,10 +60,39 @@
 // The default number of transfers to benchmark
 #define DEFAULT_NUM_TRANSFERS       1000
 
-// The pattern that we fill into the buffers
-#define TEST_PATTERN(i) ((int)(0x1234ACDE ^ (i)))
+// The seed of the pattern that we fill into the buffers
+#define TEST_PATTERN_SEED           ((int)0x1234ACDE)
 
-// The DMA context passed to the helper thread, who handles remainder channels
+// Converts a timespec structure to a time in nanoseconds
+#define TSPEC_TO_NS(tspec) \
+    ((long long)(tspec).tv_sec * 1000000000LL + (tspec).tv_nsec)
+
+// The number of bins used for the printed latency histogram
+#define HISTOGRAM_BINS              16
+
+// The width in characters of the longest latency histogram bar
+#define HISTOGRAM_BAR_WIDTH         50
+
+// The bounds of the transfer-size sweep (geometric, doubling each step)
+#define SWEEP_MIN_SIZE              (4 * 1024)
+#define SWEEP_MAX_SIZE              (64 * 1024 * 1024)
+
+// The minimum number of transfers performed per size in the sweep
+#define SWEEP_MIN_TRANSFERS         10
+
+// The DMA context passed to each thread in the multi-channel mode
+struct channel_pair_context {
+    axidma_dev_t dev;               // The AXI DMA device handle
+    int tx_channel;                 // Transmit channel driven by the thread
+    int rx_channel;                 // Receive channel driven by the thread
+    char *tx_buf;                   // The thread's transmit buffer
+    char *rx_buf;                   // The thread's receive buffer
+    size_t tx_size;                 // Size of each transmit transfer
+    size_t rx_size;                 // Size of each receive transfer
+    int num_transfers;              // The number of transfers to perform
+    int rc;                         // The result of the thread's transfers
+    double elapsed_time;            // Wall time the transfers took (seconds)
+};
 
 /*----------------------------------------------------------------------------
  * Command-line Interface
@@ -70,11 +104,13 @@ static void print_usage(bool help)
     FILE* stream = (help) ? stdout : stderr;
     double default_size;
 
-    fprintf(stream, "Usage: axidma_benchmark [-v] [-t <(V)DMA tx channel>] "
+    fprintf(stream, "Usage: axidma_benchmark [-v] [-m] [-w] "
+            "[-t <(V)DMA tx channel>] "
             "[-r <(V)DMA rx channel>] [-i <Tx transfer size (MiB)>] "
             "[-b <Tx transfer size (bytes)>] [-f <Tx frame size (HxWxD)>] "
             "[-o <Rx transfer size (MiB)>] [-s <Rx transfer size (bytes)>] "
-            "[-g <Rx frame size (HxWxD)>] [-n <number transfers>]\n");
+            "[-g <Rx frame size (HxWxD)>] [-n <number transfers>] "
+            "[-c <CSV output file>] [-j <JSON output file>]\n");
     if (!help) {
         return;
     }
@@ -82,6 +118,12 @@ static void print_usage(bool help)
     default_size = BYTE_TO_MIB(DEFAULT_TRANSFER_SIZE);
     fprintf(stream, "\t-v:\t\t\t\tUse the AXI VDMA channels instead of AXI DMA "
             "ones for the transfer.\n");
+    fprintf(stream, "\t-m:\t\t\t\tDrive every available tx/rx channel pair "
+            "concurrently, one thread per pair, and report per-channel and "
+            "aggregate throughput. Incompatible with -v.\n");
+    fprintf(stream, "\t-w:\t\t\t\tSweep a geometric series of transfer sizes "
+            "(4 KiB to 64 MiB) and print a size-vs-throughput table. "
+            "Incompatible with -v.\n");
     fprintf(stream, "\t-t <DMA tx channel>:\t\t\tThe device id of the DMA "
             "channel to use for transmitting the data to the PL fabric.\n");
     fprintf(stream, "\t-r <DMA rx channel>:\t\t\tThe device id of the DMA "
@@ -107,6 +149,10 @@ static void print_usage(bool help)
     fprintf(stream, "\t-n <number transfers>:\t\t\tThe number of DMA transfers "
             "to perform to do the benchmark. Default is %d transfers.\n",
             DEFAULT_NUM_TRANSFERS);
+    fprintf(stream, "\t-c <CSV output file>:\t\t\tWrite the latency of every "
+            "transfer to the given file as CSV.\n");
+    fprintf(stream, "\t-j <JSON output file>:\t\t\tWrite the run's parameters "
+            "and statistics to the given file as JSON.\n");
     return;
 }
 
@@ -114,7 +160,8 @@ static void print_usage(bool help)
  * and number of transfer to use for the benchmark if specified. */
 static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
         size_t *tx_size, struct axidma_video_frame *tx_frame, size_t *rx_size,
-        struct axidma_video_frame *rx_frame, int *num_transfers, bool *use_vdma)
+        struct axidma_video_frame *rx_frame, int *num_transfers, bool *use_vdma,
+        bool *multi_mode, bool *sweep_mode, char **csv_path, char **json_path)
 {
     double double_arg;
     int int_arg;
@@ -123,6 +170,8 @@ static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
 
     // Set the default data size and number of transfers
     *use_vdma = false;
+    *multi_mode = false;
+    *sweep_mode = false;
     *tx_channel = -1;
     *rx_channel = -1;
     *tx_size = DEFAULT_TRANSFER_SIZE;
@@ -134,8 +183,11 @@ static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
     rx_frame->width = -1;
     rx_frame->depth = -1;
     *num_transfers = DEFAULT_NUM_TRANSFERS;
+    *csv_path = NULL;
+    *json_path = NULL;
 
-    while ((option = getopt(argc, argv, "vt:r:i:b:f:o:s:g:n:h")) != (char)-1)
+    while ((option = getopt(argc, argv, "vmwt:r:i:b:f:o:s:g:n:c:j:h")) !=
+           (char)-1)
     {
         switch (option)
         {
@@ -143,6 +195,16 @@ static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
                 *use_vdma = true;
                 break;
 
+            // Parse the multi-channel mode flag
+            case 'm':
+                *multi_mode = true;
+                break;
+
+            // Parse the transfer-size sweep mode flag
+            case 'w':
+                *sweep_mode = true;
+                break;
+
             // Parse the transmit channel argument
             case 't':
                 if (parse_int(option, optarg, &int_arg) < 0) {
@@ -238,6 +300,16 @@ static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
                 *num_transfers = int_arg;
                 break;
 
+            // Parse the CSV output file argument
+            case 'c':
+                *csv_path = optarg;
+                break;
+
+            // Parse the JSON output file argument
+            case 'j':
+                *json_path = optarg;
+                break;
+
             // Print detailed usage message
             case 'h':
                 print_usage(true);
@@ -268,6 +340,17 @@ static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
         return -EINVAL;
     }
 
+    if (*use_vdma && (*multi_mode || *sweep_mode)) {
+        fprintf(stderr, "Error: The -m and -w options only work with the AXI "
+                "DMA channels, so they cannot be combined with -v.\n");
+        return -EINVAL;
+    }
+
+    if (*multi_mode && *sweep_mode) {
+        fprintf(stderr, "Error: Only one of -m and -w may be specified.\n");
+        return -EINVAL;
+    }
+
     return 0;
 }
 
@@ -276,96 +359,40 @@ static int parse_args(int argc, char **argv, int *tx_channel, int *rx_channel,
  *----------------------------------------------------------------------------*/
 
 /* Initialize the two buffers, filling buffers with a preset but "random"
- * pattern. */
+ * pattern. The fill kernel is NEON vectorized on ARM cores. */
 static void init_data(char *tx_buf, char *rx_buf, size_t tx_buf_size,
                       size_t rx_buf_size)
 {
-    size_t i;
-    int *transmit_buffer, *receive_buffer;
-
-    transmit_buffer = (int *)tx_buf;
-    receive_buffer = (int *)rx_buf;
-
-    // Fill the buffer with integer patterns
-    for (i = 0; i < tx_buf_size / sizeof(int); i++)
-    {
-        transmit_buffer[i] = TEST_PATTERN(i);
-    }
-
-    // Fill in any leftover bytes if it's not aligned
-    for (i = 0; i < tx_buf_size % sizeof(int); i++)
-    {
-        tx_buf[i] = TEST_PATTERN(i + tx_buf_size / sizeof(int));
-    }
-
-    // Fill the buffer with integer patterns
-    for (i = 0; i < rx_buf_size / sizeof(int); i++)
-    {
-        receive_buffer[i] = TEST_PATTERN(i + tx_buf_size);
-    }
-
-    // Fill in any leftover bytes if it's not aligned
-    for (i = 0; i < rx_buf_size % sizeof(int); i++)
-    {
-        rx_buf[i] = TEST_PATTERN(i + tx_buf_size + rx_buf_size / sizeof(int));
-    }
-
+    pattern_fill(tx_buf, tx_buf_size, TEST_PATTERN_SEED, 0);
+    pattern_fill(rx_buf, rx_buf_size, TEST_PATTERN_SEED, tx_buf_size);
     return;
 }
 
 /* Verify the two buffers. For transmit, verify that it is unchanged. For
  * receive, we don't know the PL fabric function, so the best we can
- * do is check if it changed and warn the user if it is not. */
+ * do is check if it changed and warn the user if it is not. The verify
+ * kernels are NEON vectorized on ARM cores, which keeps verification cheap
+ * enough to leave enabled at large transfer sizes. */
 static int verify_data(char *tx_buf, char *rx_buf, size_t tx_buf_size,
                        size_t rx_buf_size)
 {
-    int *transmit_buffer, *receive_buffer;
-    size_t i, rx_data_same, rx_data_units;
+    int mismatch;
+    size_t rx_data_same, rx_data_units;
     double match_fraction;
 
-    transmit_buffer = (int *)tx_buf;
-    receive_buffer = (int *)rx_buf;
-
-    // Verify words in the transmit buffer
-    for (i = 0; i < tx_buf_size / sizeof(int); i++)
-    {
-        if (transmit_buffer[i] != TEST_PATTERN(i)) {
-            fprintf(stderr, "Test failed! The transmit buffer was overwritten "
-                    "at byte %zu.\n", i);
-            fprintf(stderr, "Expected 0x%08x, found 0x%08x.\n", TEST_PATTERN(i),
-                    tx_buf[i]);
-            return -EINVAL;
-        }
-    }
-
-    // Verify any leftover bytes in the buffer
-    for (i = 0; i < tx_buf_size % sizeof(int); i++)
-    {
-        if (tx_buf[i] != TEST_PATTERN(i + tx_buf_size / sizeof(int))) {
-            fprintf(stderr, "Test failed! The transmit buffer was overwritten "
-                    "at byte %zu.\n", i);
-            fprintf(stderr, "Expected 0x%08x, found 0x%08x.\n", TEST_PATTERN(i),
-                    tx_buf[i]);
-            return -EINVAL;
-        }
-    }
-
-    // Verify words in the receive buffer
-    rx_data_same = 0;
-    for (i = 0; i < rx_buf_size / sizeof(int); i++)
-    {
-        if (receive_buffer[i] == TEST_PATTERN(i+tx_buf_size)) {
-            rx_data_same += 1;
-        }
+    // Verify that the transmit buffer is unchanged
+    mismatch = pattern_check(tx_buf, tx_buf_size, TEST_PATTERN_SEED, 0);
+    if (mismatch >= 0) {
+        fprintf(stderr, "Test failed! The transmit buffer was overwritten "
+                "at word %d.\n", mismatch);
+        fprintf(stderr, "Expected 0x%08x, found 0x%08x.\n",
+                TEST_PATTERN_SEED ^ mismatch, ((int *)tx_buf)[mismatch]);
+        return -EINVAL;
     }
 
-    // Verify any leftover bytes in the buffer
-    for (i = 0; i < rx_buf_size % sizeof(int); i++)
-    {
-        if (rx_buf[i] == TEST_PATTERN(i+tx_buf_size+rx_buf_size/sizeof(int))) {
-            rx_data_same += 1;
-        }
-    }
+    // Count the receive buffer words still matching the initialization
+    rx_data_same = pattern_count_matches(rx_buf, rx_buf_size,
+            TEST_PATTERN_SEED, tx_buf_size);
 
     // Warn the user if more than 10% of the pixels match the test pattern
     rx_data_units = rx_buf_size / sizeof(int) + rx_buf_size % sizeof(int);
@@ -388,66 +415,474 @@ static int single_transfer_test(axidma_dev_t dev, int tx_channel, void *tx_buf,
         void *rx_buf, int rx_size, struct axidma_video_frame *rx_frame)
 {
     int rc;
+    struct timespec start_time, end_time;
+    double transfer_time, verify_time;
 
     // Initialize the buffer region we're going to transmit
     init_data(tx_buf, rx_buf, tx_size, rx_size);
 
     // Perform the DMA transaction
+    clock_gettime(CLOCK_MONOTONIC_RAW, &start_time);
     rc = axidma_twoway_transfer(dev, tx_channel, tx_buf, tx_size, tx_frame,
             rx_channel, rx_buf, rx_size, rx_frame, true);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &end_time);
     if (rc < 0) {
         return rc;
     }
+    transfer_time = (TSPEC_TO_NS(end_time) - TSPEC_TO_NS(start_time)) / 1e6;
 
     // Verify that the data in the buffer changed
-    return verify_data(tx_buf, rx_buf, tx_size, rx_size);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &start_time);
+    rc = verify_data(tx_buf, rx_buf, tx_size, rx_size);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &end_time);
+    if (rc < 0) {
+        return rc;
+    }
+    verify_time = (TSPEC_TO_NS(end_time) - TSPEC_TO_NS(start_time)) / 1e6;
+
+    // Report the verify time separately, so it cannot hide the DMA numbers
+    printf("Single Transfer Time: %0.2f ms\n", transfer_time);
+    printf("Single Verify Time: %0.2f ms\n", verify_time);
+    return 0;
 }
 
 /*----------------------------------------------------------------------------
  * Benchmarking Test
  *----------------------------------------------------------------------------*/
 
-/* Profiles the transfer and receive rates for the DMA, reporting the throughput
- * of each channel in MiB/s. */
+// Compares two latencies for qsort, ordering them ascending
+static int compare_latency(const void *a, const void *b)
+{
+    long long lat_a, lat_b;
+
+    lat_a = *(const long long *)a;
+    lat_b = *(const long long *)b;
+    if (lat_a < lat_b) {
+        return -1;
+    } else if (lat_a > lat_b) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/* Returns the given percentile of the sorted latency array, using the
+ * nearest-rank method. */
+static long long latency_percentile(const long long *latencies,
+        int num_transfers, double percentile)
+{
+    int index;
+
+    index = (int)((percentile / 100.0) * (num_transfers - 1) + 0.5);
+    return latencies[index];
+}
+
+// Prints a histogram of the sorted latency array to standard output
+static void print_latency_histogram(const long long *latencies,
+        int num_transfers)
+{
+    int i, bin, bar_len;
+    int bins[HISTOGRAM_BINS];
+    int max_count;
+    long long min_latency, max_latency, bin_width;
+
+    /* Divide the observed latency range evenly across the bins. The width is
+     * rounded up, so the maximum latency always lands in the last bin. */
+    min_latency = latencies[0];
+    max_latency = latencies[num_transfers-1];
+    bin_width = (max_latency - min_latency) / HISTOGRAM_BINS + 1;
+
+    // Count the number of transfers that fall into each bin
+    memset(bins, 0, sizeof(bins));
+    max_count = 0;
+    for (i = 0; i < num_transfers; i++)
+    {
+        bin = (latencies[i] - min_latency) / bin_width;
+        bins[bin] += 1;
+        if (bins[bin] > max_count) {
+            max_count = bins[bin];
+        }
+    }
+
+    // Print each bin's range, count, and a bar scaled to the largest bin
+    printf("\tLatency Histogram:\n");
+    for (bin = 0; bin < HISTOGRAM_BINS; bin++)
+    {
+        bar_len = (bins[bin] * HISTOGRAM_BAR_WIDTH) / max_count;
+        printf("\t%9.1f - %9.1f us [%6d] ",
+               (min_latency + bin * bin_width) / 1000.0,
+               (min_latency + (bin + 1) * bin_width) / 1000.0, bins[bin]);
+        for (i = 0; i < bar_len; i++)
+        {
+            printf("#");
+        }
+        printf("\n");
+    }
+
+    return;
+}
+
+/* Writes the latency of every transfer to the given file as CSV, one row per
+ * transfer in submission order. */
+static int write_latency_csv(const char *csv_path, const long long *latencies,
+        int num_transfers)
+{
+    int i;
+    FILE *csv_file;
+
+    csv_file = fopen(csv_path, "w");
+    if (csv_file == NULL) {
+        perror("Unable to open the CSV output file");
+        return -errno;
+    }
+
+    fprintf(csv_file, "transfer,latency_ns\n");
+    for (i = 0; i < num_transfers; i++)
+    {
+        fprintf(csv_file, "%d,%lld\n", i, latencies[i]);
+    }
+
+    fclose(csv_file);
+    return 0;
+}
+
+/* Writes the run's parameters, throughput, and latency statistics to the
+ * given file as a JSON object, for machine consumption across runs. */
+static int write_stats_json(const char *json_path, int tx_size, int rx_size,
+        int num_transfers, double elapsed_time, double tx_data_rate,
+        double rx_data_rate, const long long *sorted_latencies)
+{
+    FILE *json_file;
+
+    json_file = fopen(json_path, "w");
+    if (json_file == NULL) {
+        perror("Unable to open the JSON output file");
+        return -errno;
+    }
+
+    fprintf(json_file, "{\n");
+    fprintf(json_file, "  \"tx_size_bytes\": %d,\n", tx_size);
+    fprintf(json_file, "  \"rx_size_bytes\": %d,\n", rx_size);
+    fprintf(json_file, "  \"num_transfers\": %d,\n", num_transfers);
+    fprintf(json_file, "  \"elapsed_sec\": %f,\n", elapsed_time);
+    fprintf(json_file, "  \"tx_throughput_mibps\": %f,\n", tx_data_rate);
+    fprintf(json_file, "  \"rx_throughput_mibps\": %f,\n", rx_data_rate);
+    fprintf(json_file, "  \"total_throughput_mibps\": %f,\n",
+            tx_data_rate + rx_data_rate);
+    fprintf(json_file, "  \"latency_ns\": {\n");
+    fprintf(json_file, "    \"min\": %lld,\n", sorted_latencies[0]);
+    fprintf(json_file, "    \"p50\": %lld,\n",
+            latency_percentile(sorted_latencies, num_transfers, 50.0));
+    fprintf(json_file, "    \"p90\": %lld,\n",
+            latency_percentile(sorted_latencies, num_transfers, 90.0));
+    fprintf(json_file, "    \"p99\": %lld,\n",
+            latency_percentile(sorted_latencies, num_transfers, 99.0));
+    fprintf(json_file, "    \"p99.9\": %lld,\n",
+            latency_percentile(sorted_latencies, num_transfers, 99.9));
+    fprintf(json_file, "    \"max\": %lld\n",
+            sorted_latencies[num_transfers-1]);
+    fprintf(json_file, "  }\n");
+    fprintf(json_file, "}\n");
+
+    fclose(json_file);
+    return 0;
+}
+
+/* Profiles the transfer and receive rates for the DMA, reporting the
+ * throughput of each channel in MiB/s, and the per-transfer latency
+ * percentiles in microseconds. */
 static int time_dma(axidma_dev_t dev, int tx_channel, void *tx_buf, int tx_size,
         struct axidma_video_frame *tx_frame, int rx_channel, void *rx_buf,
-        int rx_size, struct axidma_video_frame *rx_frame, int num_transfers)
+        int rx_size, struct axidma_video_frame *rx_frame, int num_transfers,
+        const char *csv_path, const char *json_path)
 {
     int i, rc;
-    struct timeval start_time, end_time;
+    struct timespec start_time, end_time;
     double elapsed_time, tx_data_rate, rx_data_rate;
+    long long *latencies;
 
-    // Begin timing
-    gettimeofday(&start_time, NULL);
+    // Allocate an array to record the latency of every transfer
+    latencies = malloc(num_transfers * sizeof(latencies[0]));
+    if (latencies == NULL) {
+        fprintf(stderr, "Unable to allocate the latency array.\n");
+        return -ENOMEM;
+    }
 
-    // Perform n transfers
+    /* Perform n transfers, timestamping each one individually with the raw
+     * monotonic clock, so the latencies are immune to clock adjustments. */
     for (i = 0; i < num_transfers; i++)
     {
+        clock_gettime(CLOCK_MONOTONIC_RAW, &start_time);
         rc = axidma_twoway_transfer(dev, tx_channel, tx_buf, tx_size, tx_frame,
                 rx_channel, rx_buf, rx_size, rx_frame, true);
+        clock_gettime(CLOCK_MONOTONIC_RAW, &end_time);
         if (rc < 0) {
             fprintf(stderr, "DMA failed on transfer %d, not reporting timing "
                     "results.\n", i+1);
-            return rc;
+            goto free_latencies;
         }
+        latencies[i] = TSPEC_TO_NS(end_time) - TSPEC_TO_NS(start_time);
     }
 
-    // End timing
-    gettimeofday(&end_time, NULL);
-
-    // Compute the throughput of each channel
-    elapsed_time = TVAL_TO_SEC(end_time) - TVAL_TO_SEC(start_time);
+    // Compute the total elapsed time and the throughput of each channel
+    elapsed_time = 0.0;
+    for (i = 0; i < num_transfers; i++)
+    {
+        elapsed_time += latencies[i] / 1e9;
+    }
     tx_data_rate = BYTE_TO_MIB(tx_size) * num_transfers / elapsed_time;
     rx_data_rate = BYTE_TO_MIB(rx_size) * num_transfers / elapsed_time;
 
-    // Report the statistics to the user
+    // Report the throughput statistics to the user
     printf("DMA Timing Statistics:\n");
     printf("\tElapsed Time: %0.2f s\n", elapsed_time);
     printf("\tTransmit Throughput: %0.2f MiB/s\n", tx_data_rate);
     printf("\tReceive Throughput: %0.2f MiB/s\n", rx_data_rate);
     printf("\tTotal Throughput: %0.2f MiB/s\n", tx_data_rate + rx_data_rate);
 
-    return 0;
+    // Write the per-transfer latencies out as CSV, if requested
+    if (csv_path != NULL) {
+        rc = write_latency_csv(csv_path, latencies, num_transfers);
+        if (rc < 0) {
+            goto free_latencies;
+        }
+    }
+
+    // Report the latency percentiles over the sorted latencies
+    qsort(latencies, num_transfers, sizeof(latencies[0]), compare_latency);
+    printf("\tLatency Min: %0.1f us\n", latencies[0] / 1000.0);
+    printf("\tLatency p50: %0.1f us\n",
+           latency_percentile(latencies, num_transfers, 50.0) / 1000.0);
+    printf("\tLatency p90: %0.1f us\n",
+           latency_percentile(latencies, num_transfers, 90.0) / 1000.0);
+    printf("\tLatency p99: %0.1f us\n",
+           latency_percentile(latencies, num_transfers, 99.0) / 1000.0);
+    printf("\tLatency p99.9: %0.1f us\n",
+           latency_percentile(latencies, num_transfers, 99.9) / 1000.0);
+    printf("\tLatency Max: %0.1f us\n",
+           latencies[num_transfers-1] / 1000.0);
+    print_latency_histogram(latencies, num_transfers);
+
+    // Write the run's statistics out as JSON, if requested
+    if (json_path != NULL) {
+        rc = write_stats_json(json_path, tx_size, rx_size, num_transfers,
+                elapsed_time, tx_data_rate, rx_data_rate, latencies);
+        if (rc < 0) {
+            goto free_latencies;
+        }
+    }
+
+    rc = 0;
+
+free_latencies:
+    free(latencies);
+    return rc;
+}
+
+/*----------------------------------------------------------------------------
+ * Multi-Channel Benchmarking Test
+ *----------------------------------------------------------------------------*/
+
+/* The body of each channel pair thread. Performs the requested number of
+ * transfers over the thread's channel pair, timing the run as a whole. */
+static void *channel_pair_thread(void *arg)
+{
+    int i;
+    struct channel_pair_context *ctx;
+    struct timespec start_time, end_time;
+
+    ctx = arg;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &start_time);
+    for (i = 0; i < ctx->num_transfers; i++)
+    {
+        ctx->rc = axidma_twoway_transfer(ctx->dev, ctx->tx_channel,
+                ctx->tx_buf, ctx->tx_size, NULL, ctx->rx_channel, ctx->rx_buf,
+                ctx->rx_size, NULL, true);
+        if (ctx->rc < 0) {
+            fprintf(stderr, "DMA failed on transfer %d of channel pair "
+                    "%d/%d.\n", i+1, ctx->tx_channel, ctx->rx_channel);
+            return NULL;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC_RAW, &end_time);
+
+    ctx->elapsed_time = (TSPEC_TO_NS(end_time) - TSPEC_TO_NS(start_time))
+                        / 1e9;
+    return NULL;
+}
+
+/* Profiles the aggregate transfer rate with every available tx/rx channel
+ * pair running concurrently, one thread per pair. The per-channel rates
+ * expose interrupt-handling and locking bottlenecks in the driver that a
+ * single-channel run cannot, since the channels contend for them. */
+static int time_dma_multi(axidma_dev_t dev, const array_t *tx_chans,
+        const array_t *rx_chans, size_t tx_size, size_t rx_size,
+        int num_transfers)
+{
+    int i, rc, num_pairs, num_threads;
+    double pair_rate, total_rate;
+    struct channel_pair_context *contexts;
+    pthread_t *threads;
+
+    // Pair up the channels; any leftover channels of one direction are idle
+    num_pairs = (tx_chans->len < rx_chans->len) ? tx_chans->len
+                                                : rx_chans->len;
+    printf("Running %d transfers on %d channel pairs concurrently.\n\n",
+           num_transfers, num_pairs);
+
+    // Allocate the thread handles and per-thread contexts
+    contexts = calloc(num_pairs, sizeof(contexts[0]));
+    threads = malloc(num_pairs * sizeof(threads[0]));
+    if (contexts == NULL || threads == NULL) {
+        fprintf(stderr, "Unable to allocate the thread contexts.\n");
+        rc = -ENOMEM;
+        goto free_contexts;
+    }
+
+    // Allocate each pair its own buffers, so the threads never share data
+    rc = 0;
+    for (i = 0; i < num_pairs; i++)
+    {
+        contexts[i].dev = dev;
+        contexts[i].tx_channel = tx_chans->data[i];
+        contexts[i].rx_channel = rx_chans->data[i];
+        contexts[i].tx_size = tx_size;
+        contexts[i].rx_size = rx_size;
+        contexts[i].num_transfers = num_transfers;
+        contexts[i].tx_buf = axidma_malloc(dev, tx_size);
+        contexts[i].rx_buf = axidma_malloc(dev, rx_size);
+        if (contexts[i].tx_buf == NULL || contexts[i].rx_buf == NULL) {
+            perror("Unable to allocate the channel pair buffers");
+            rc = -ENOMEM;
+            goto free_buffers;
+        }
+    }
+
+    // Spawn one thread per channel pair, then wait for all of them to finish
+    num_threads = 0;
+    for (i = 0; i < num_pairs; i++)
+    {
+        rc = pthread_create(&threads[i], NULL, channel_pair_thread,
+                &contexts[i]);
+        if (rc != 0) {
+            fprintf(stderr, "Unable to create the channel pair thread: %s.\n",
+                    strerror(rc));
+            rc = -rc;
+            break;
+        }
+        num_threads += 1;
+    }
+    for (i = 0; i < num_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+        if (contexts[i].rc < 0) {
+            rc = contexts[i].rc;
+        }
+    }
+    if (rc < 0 || num_threads < num_pairs) {
+        goto free_buffers;
+    }
+
+    /* Report the throughput of each channel pair, and the aggregate across
+     * all of them. Each pair's rate covers both of its directions. */
+    printf("Multi-Channel DMA Timing Statistics:\n");
+    total_rate = 0.0;
+    for (i = 0; i < num_pairs; i++)
+    {
+        pair_rate = (BYTE_TO_MIB(tx_size) + BYTE_TO_MIB(rx_size))
+                    * num_transfers / contexts[i].elapsed_time;
+        total_rate += pair_rate;
+        printf("\tChannel Pair %d/%d: %0.2f MiB/s (%0.2f s)\n",
+               contexts[i].tx_channel, contexts[i].rx_channel, pair_rate,
+               contexts[i].elapsed_time);
+    }
+    printf("\tAggregate Throughput: %0.2f MiB/s\n", total_rate);
+
+free_buffers:
+    for (i = 0; i < num_pairs; i++)
+    {
+        if (contexts[i].tx_buf != NULL) {
+            axidma_free(dev, contexts[i].tx_buf, tx_size);
+        }
+        if (contexts[i].rx_buf != NULL) {
+            axidma_free(dev, contexts[i].rx_buf, rx_size);
+        }
+    }
+free_contexts:
+    free(threads);
+    free(contexts);
+    return rc;
+}
+
+/*----------------------------------------------------------------------------
+ * Transfer-Size Sweep
+ *----------------------------------------------------------------------------*/
+
+/* Sweeps a geometric series of transfer sizes over the given channel pair,
+ * printing a size-vs-throughput table. Running the whole series in one
+ * process keeps the per-run startup cost out of the small-size results. The
+ * transfer count is scaled down as the size grows, so each size moves
+ * roughly the same amount of data. */
+static int sweep_dma(axidma_dev_t dev, int tx_channel, int rx_channel,
+        int num_transfers)
+{
+    int i, rc, size_transfers;
+    size_t size;
+    char *tx_buf, *rx_buf;
+    struct timespec start_time, end_time;
+    double elapsed_time, data_rate;
+
+    // Allocate the buffers at the largest size once, and reuse them
+    tx_buf = axidma_malloc(dev, SWEEP_MAX_SIZE);
+    if (tx_buf == NULL) {
+        perror("Unable to allocate the sweep transmit buffer");
+        return -ENOMEM;
+    }
+    rx_buf = axidma_malloc(dev, SWEEP_MAX_SIZE);
+    if (rx_buf == NULL) {
+        perror("Unable to allocate the sweep receive buffer");
+        rc = -ENOMEM;
+        goto free_tx_buf;
+    }
+
+    printf("Transfer-Size Sweep:\n");
+    printf("\t%12s %10s %14s %14s\n", "Size (KiB)", "Transfers",
+           "Tx (MiB/s)", "Total (MiB/s)");
+
+    rc = 0;
+    for (size = SWEEP_MIN_SIZE; size <= SWEEP_MAX_SIZE; size *= 2)
+    {
+        // Scale the count down with the size, keeping the data volume even
+        size_transfers = num_transfers / (int)(size / SWEEP_MIN_SIZE);
+        if (size_transfers < SWEEP_MIN_TRANSFERS) {
+            size_transfers = SWEEP_MIN_TRANSFERS;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC_RAW, &start_time);
+        for (i = 0; i < size_transfers; i++)
+        {
+            rc = axidma_twoway_transfer(dev, tx_channel, tx_buf, size, NULL,
+                    rx_channel, rx_buf, size, NULL, true);
+            if (rc < 0) {
+                fprintf(stderr, "DMA failed on transfer %d of size %zu.\n",
+                        i+1, size);
+                goto free_rx_buf;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC_RAW, &end_time);
+
+        elapsed_time = (TSPEC_TO_NS(end_time) - TSPEC_TO_NS(start_time))
+                       / 1e9;
+        data_rate = BYTE_TO_MIB(size) * size_transfers / elapsed_time;
+        printf("\t%12zu %10d %14.2f %14.2f\n", size / 1024, size_transfers,
+               data_rate, 2.0 * data_rate);
+    }
+
+free_rx_buf:
+    axidma_free(dev, rx_buf, SWEEP_MAX_SIZE);
+free_tx_buf:
+    axidma_free(dev, tx_buf, SWEEP_MAX_SIZE);
+    return rc;
 }
 
 /*----------------------------------------------------------------------------
@@ -460,8 +895,9 @@ int main(int argc, char **argv)
     int num_transfers;
     int tx_channel, rx_channel;
     size_t tx_size, rx_size;
-    bool use_vdma;
+    bool use_vdma, multi_mode, sweep_mode;
     char *tx_buf, *rx_buf;
+    char *csv_path, *json_path;
     axidma_dev_t axidma_dev;
     const array_t *tx_chans, *rx_chans;
     struct axidma_video_frame transmit_frame, *tx_frame, receive_frame, *rx_frame;
@@ -469,7 +905,7 @@ int main(int argc, char **argv)
     // Check if the user overrided the default transfer size and number
     if (parse_args(argc, argv, &tx_channel, &rx_channel, &tx_size,
             &transmit_frame, &rx_size, &receive_frame, &num_transfers,
-            &use_vdma) < 0) {
+            &use_vdma, &multi_mode, &sweep_mode, &csv_path, &json_path) < 0) {
         rc = 1;
         goto ret;
     }
@@ -551,8 +987,16 @@ int main(int argc, char **argv)
 
     // Time the DMA eingine
     printf("Beginning performance analysis of the DMA engine.\n\n");
-    rc = time_dma(axidma_dev, tx_channel, tx_buf, tx_size, tx_frame,
-            rx_channel, rx_buf, rx_size, rx_frame, num_transfers);
+    if (multi_mode) {
+        rc = time_dma_multi(axidma_dev, tx_chans, rx_chans, tx_size, rx_size,
+                num_transfers);
+    } else if (sweep_mode) {
+        rc = sweep_dma(axidma_dev, tx_channel, rx_channel, num_transfers);
+    } else {
+        rc = time_dma(axidma_dev, tx_channel, tx_buf, tx_size, tx_frame,
+                rx_channel, rx_buf, rx_size, rx_frame, num_transfers, csv_path,
+                json_path);
+    }
 
 free_rx_buf:
     axidma_free(axidma_dev, rx_buf, rx_size);
@@ -4,14 +4,20 @@
  * @author Brandon Perez (bmperez)
  * @author Jared Choi (jaewonch)
  *
- * This program performs a simple AXI DMA transfer. It takes the input file,
- * loads it into memory, and then sends it out over the PL fabric. It then
- * receives the data back, and places it into the given output file.
+ * This program performs a simple AXI DMA transfer. It streams the input file
+ * out over the PL fabric in chunks through a double-buffered pipeline,
+ * receives the data back, and places it into the given output file. The next
+ * chunk is read from disk while the current one is in flight on the engine
+ * and the previous one drains to the output file, so the disk I/O overlaps
+ * with the DMA and the file size is not capped by the DMA memory. When the
+ * user forces an output size different from the input size, the chunk
+ * boundaries of the result cannot be inferred, so the whole file is moved in
+ * a single transfer instead.
  *
  * By default it uses the lowest numbered channels for the transmit and receive,
  * unless overriden by the user. The amount of data transfered is automatically
  * determined from the file size. Unless specified, the output file size is
- * made to be 2 times the input size (to account for creating more data).
+ * made to be the same as the input size.
  *
  * This program also handles any additional channels that the pipeline
  * on the PL fabric might depend on. It starts up DMA transfers for these
@@ -20,6 +26,9 @@
  * @bug No known bugs.
  **/
 
+// Required for the O_DIRECT open flag
+#define _GNU_SOURCE
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -41,6 +50,12 @@
  * Internal Definitions
  *----------------------------------------------------------------------------*/
 
+// The size of each chunk streamed through the pipeline
+#define CHUNK_SIZE              (4 * 1024 * 1024)
+
+// The number of buffer pairs kept rotating through the pipeline
+#define PIPELINE_STAGES         2
+
 // A convenient structure to carry information around about the transfer
 struct dma_transfer {
     int input_fd;           // The file descriptor for the input file
@@ -63,8 +78,8 @@ static void print_usage(bool help)
     FILE* stream = (help) ? stdout : stderr;
 
     fprintf(stream, "Usage: axidma_transfer <input path> <output path> "
-            "[-t <DMA tx channel>] [-r <DMA rx channel>] [-s <Output file size>"
-            " | -o <Output file size>].\n");
+            "[-d] [-t <DMA tx channel>] [-r <DMA rx channel>] "
+            "[-s <Output file size> | -o <Output file size>].\n");
     if (!help) {
         return;
     }
@@ -73,6 +88,9 @@ static void print_usage(bool help)
             "DMA to the PL fabric. Can be a relative or absolute path.\n");
     fprintf(stream, "\t<output path>:\t\tThe path to place the received data "
             "from the PL fabric into. Can be a relative or absolute path.\n");
+    fprintf(stream, "\t-d:\t\t\tOpen the input file with O_DIRECT, bypassing "
+            "the page cache. The DMA buffers are page aligned, so the reads "
+            "land in them directly.\n");
     fprintf(stream, "\t-t <DMA tx channel>:\tThe device id of the DMA channel "
             "to use for transmitting the file. Default is to use the lowest "
             "numbered channel available.\n");
@@ -93,7 +111,8 @@ static void print_usage(bool help)
 /* Parses the command line arguments overriding the default transfer sizes,
  * and number of transfer to use for the benchmark if specified. */
 static int parse_args(int argc, char **argv, char **input_path,
-    char **output_path, int *input_channel, int *output_channel, int *output_size)
+    char **output_path, int *input_channel, int *output_channel,
+    int *output_size, bool *use_odirect)
 {
     char option;
     int int_arg;
@@ -105,14 +124,20 @@ static int parse_args(int argc, char **argv, char **input_path,
     *input_channel = -1;
     *output_channel = -1;
     *output_size = -1;
+    *use_odirect = false;
     o_specified = false;
     s_specified = false;
     rc = 0;
 
-    while ((option = getopt(argc, argv, "t:r:s:o:h")) != (char)-1)
+    while ((option = getopt(argc, argv, "dt:r:s:o:h")) != (char)-1)
     {
         switch (option)
         {
+            // Parse the direct I/O flag
+            case 'd':
+                *use_odirect = true;
+                break;
+
             // Parse the transmit channel device id
             case 't':
                 rc = parse_int(option, optarg, &int_arg);
@@ -204,6 +229,93 @@ static int parse_args(int argc, char **argv, char **input_path,
  * DMA File Transfer Functions
  *----------------------------------------------------------------------------*/
 
+/* Streams the file through a double-buffered pipeline of chunk transfers.
+ * The next chunk is read from disk while the current one is in flight on the
+ * engine and the previous one drains to the output file, so the disk I/O and
+ * the DMA overlap, and the file size is not capped by the DMA memory. The
+ * chunk lengths are tracked in submission order, since the pipeline
+ * completes its stages first-in first-out. */
+static int transfer_file_pipelined(axidma_dev_t dev, struct dma_transfer *trans,
+                                   char *output_path)
+{
+    int rc, chunk_len, in_flight, submitted, completed;
+    int chunk_lens[PIPELINE_STAGES];
+    bool eof;
+    void *tx_buf, *rx_buf;
+    axidma_pipeline_t pipeline;
+
+    // Create the pipeline of chunk-sized buffer pairs on the channels
+    pipeline = axidma_pipeline_create(dev, trans->input_channel,
+            trans->output_channel, CHUNK_SIZE, PIPELINE_STAGES);
+    if (pipeline == NULL) {
+        fprintf(stderr, "Failed to create the transfer pipeline.\n");
+        return -ENOMEM;
+    }
+    printf("Writing output data to `%s`.\n", output_path);
+
+    /* Rotate the stages: fill and submit chunks while a stage is free and
+     * input remains, then drain the oldest in-flight chunk to the output
+     * file. A full chunk is always requested from the file, so the read
+     * counts stay aligned for O_DIRECT; the last chunk comes back short. */
+    rc = 0;
+    eof = false;
+    in_flight = 0;
+    submitted = 0;
+    completed = 0;
+    while (!eof || in_flight > 0)
+    {
+        while (!eof && in_flight < PIPELINE_STAGES)
+        {
+            tx_buf = axidma_pipeline_tx_buf(pipeline);
+            assert(tx_buf != NULL);
+            chunk_len = robust_read(trans->input_fd, tx_buf, CHUNK_SIZE);
+            if (chunk_len < 0) {
+                perror("Unable to read in input chunk");
+                rc = chunk_len;
+                goto destroy_pipeline;
+            } else if (chunk_len == 0) {
+                eof = true;
+                break;
+            }
+
+            rc = axidma_pipeline_submit(pipeline, chunk_len, chunk_len);
+            if (rc < 0) {
+                fprintf(stderr, "DMA chunk transaction failed.\n");
+                goto destroy_pipeline;
+            }
+            chunk_lens[submitted % PIPELINE_STAGES] = chunk_len;
+            submitted += 1;
+            in_flight += 1;
+        }
+
+        if (in_flight > 0) {
+            rx_buf = axidma_pipeline_complete(pipeline);
+            if (rx_buf == NULL) {
+                fprintf(stderr, "DMA chunk transaction failed.\n");
+                rc = -EIO;
+                goto destroy_pipeline;
+            }
+            rc = robust_write(trans->output_fd, rx_buf,
+                    chunk_lens[completed % PIPELINE_STAGES]);
+            if (rc < 0) {
+                perror("Unable to write output chunk");
+                goto destroy_pipeline;
+            }
+            completed += 1;
+            in_flight -= 1;
+        }
+    }
+    rc = 0;
+
+destroy_pipeline:
+    axidma_pipeline_destroy(pipeline);
+    return rc;
+}
+
+/* Moves the whole file in a single transfer. This caps the file size by the
+ * available DMA memory, but it is the only option when the output size
+ * differs from the input size, since the chunk boundaries of the result
+ * cannot be inferred in that case. */
 static int transfer_file(axidma_dev_t dev, struct dma_transfer *trans,
                          char *output_path)
 {
@@ -259,6 +371,7 @@ ret:
 int main(int argc, char **argv)
 {
     int rc;
+    bool use_odirect;
     char *input_path, *output_path;
     axidma_dev_t axidma_dev;
     struct stat input_stat;
@@ -268,13 +381,15 @@ int main(int argc, char **argv)
     // Parse the input arguments
     memset(&trans, 0, sizeof(trans));
     if (parse_args(argc, argv, &input_path, &output_path, &trans.input_channel,
-                   &trans.output_channel, &trans.output_size) < 0) {
+                   &trans.output_channel, &trans.output_size,
+                   &use_odirect) < 0) {
         rc = 1;
         goto ret;
     }
 
     // Try opening the input and output images
-    trans.input_fd = open(input_path, O_RDONLY);
+    trans.input_fd = open(input_path, O_RDONLY | ((use_odirect) ? O_DIRECT
+                                                                : 0));
     if (trans.input_fd < 0) {
         perror("Error opening input file");
         rc = 1;
@@ -335,8 +450,13 @@ int main(int argc, char **argv)
     printf("\tInput File Size: %.2f MiB\n", BYTE_TO_MIB(trans.input_size));
     printf("\tOutput File Size: %.2f MiB\n\n", BYTE_TO_MIB(trans.output_size));
 
-    // Transfer the file over the AXI DMA
-    rc = transfer_file(axidma_dev, &trans, output_path);
+    /* Transfer the file over the AXI DMA, streaming it in chunks unless the
+     * user forced an output size different from the input size. */
+    if (trans.output_size == trans.input_size) {
+        rc = transfer_file_pipelined(axidma_dev, &trans, output_path);
+    } else {
+        rc = transfer_file(axidma_dev, &trans, output_path);
+    }
     rc = (rc < 0) ? -rc : 0;
 
 destroy_axidma:
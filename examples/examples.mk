@@ -30,8 +30,10 @@ UTIL_DIR = $(EXAMPLES_DIR)
 UTIL_FILES = util.c
 UTIL = $(addprefix $(UTIL_DIR)/,$(UTIL_FILES))
 
-# The compiler flags used to compile the examples
-EXAMPLES_CFLAGS = $(GLOBAL_CFLAGS)
+# The compiler flags used to compile the examples. The benchmark drives one
+# channel pair per thread in its multi-channel mode, so the examples need the
+# pthread support.
+EXAMPLES_CFLAGS = $(GLOBAL_CFLAGS) -pthread
 
 # Set the example executables to link against the AXI DMA shared library in
 # the outputs directory
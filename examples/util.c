@@ -20,6 +20,11 @@
 #include <unistd.h>             // Read() and write()
 #include <errno.h>              // Error codes
 
+// NEON intrinsics, available on ARM cores with the Advanced SIMD extension
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 /*----------------------------------------------------------------------------
  * Command-Line Parsing Utilities
  *----------------------------------------------------------------------------*/
@@ -78,6 +83,162 @@ int parse_resolution(char option, char *arg_str, int *height, int *width,
     return 0;
 }
 
+/*----------------------------------------------------------------------------
+ * Test Pattern Utilities
+ *----------------------------------------------------------------------------*/
+
+/* These kernels fill and verify buffers with a test pattern, where 32-bit
+ * word i holds seed ^ (base + i). On ARM cores with NEON, the words are
+ * processed four lanes at a time, which speeds the kernels up enough over
+ * the scalar loops to keep verification enabled at large transfer sizes;
+ * elsewhere the scalar loops are used. */
+
+// Fills the buffer with the test pattern, starting from the given word base
+void pattern_fill(char *buf, int buf_size, int seed, int base)
+{
+    int i, num_words;
+    int *words;
+
+    words = (int *)buf;
+    num_words = buf_size / (int)sizeof(int);
+    i = 0;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static const uint32_t lane_offsets[4] = {0, 1, 2, 3};
+    uint32x4_t vseed, vindex, vstep;
+
+    // Generate four pattern words per iteration, stepping the indices by 4
+    vseed = vdupq_n_u32(seed);
+    vindex = vaddq_u32(vdupq_n_u32(base), vld1q_u32(lane_offsets));
+    vstep = vdupq_n_u32(4);
+    for (; i + 4 <= num_words; i += 4)
+    {
+        vst1q_u32((uint32_t *)&words[i], veorq_u32(vseed, vindex));
+        vindex = vaddq_u32(vindex, vstep);
+    }
+#endif
+
+    for (; i < num_words; i++)
+    {
+        words[i] = seed ^ (base + i);
+    }
+
+    // Fill in any leftover bytes if the size is not word aligned
+    for (i = 0; i < buf_size % (int)sizeof(int); i++)
+    {
+        buf[num_words * sizeof(int) + i] = seed ^ (base + num_words + i);
+    }
+
+    return;
+}
+
+/* Checks the buffer against the test pattern, returning the word index of
+ * the first mismatch, or -1 if the whole buffer matches. */
+int pattern_check(char *buf, int buf_size, int seed, int base)
+{
+    int i, num_words;
+    int *words;
+
+    words = (int *)buf;
+    num_words = buf_size / (int)sizeof(int);
+    i = 0;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static const uint32_t lane_offsets[4] = {0, 1, 2, 3};
+    uint32x4_t vseed, vindex, vstep, vmask;
+    uint64x2_t vmask64;
+
+    /* Compare four words per iteration. A mismatch is the rare case, so the
+     * block is only rescanned by the scalar loop when one is found. */
+    vseed = vdupq_n_u32(seed);
+    vindex = vaddq_u32(vdupq_n_u32(base), vld1q_u32(lane_offsets));
+    vstep = vdupq_n_u32(4);
+    for (; i + 4 <= num_words; i += 4)
+    {
+        vmask = vceqq_u32(vld1q_u32((uint32_t *)&words[i]),
+                          veorq_u32(vseed, vindex));
+        vmask64 = vreinterpretq_u64_u32(vmask);
+        if ((vgetq_lane_u64(vmask64, 0) & vgetq_lane_u64(vmask64, 1))
+                != (uint64_t)-1) {
+            break;
+        }
+        vindex = vaddq_u32(vindex, vstep);
+    }
+#endif
+
+    for (; i < num_words; i++)
+    {
+        if (words[i] != (seed ^ (base + i))) {
+            return i;
+        }
+    }
+
+    // Check any leftover bytes if the size is not word aligned
+    for (i = 0; i < buf_size % (int)sizeof(int); i++)
+    {
+        if (buf[num_words * sizeof(int) + i] !=
+                (char)(seed ^ (base + num_words + i))) {
+            return num_words + i;
+        }
+    }
+
+    return -1;
+}
+
+/* Counts the words of the buffer that match the test pattern. This is used
+ * when the expected contents are unknown, to estimate how much of the buffer
+ * was updated. */
+int pattern_count_matches(char *buf, int buf_size, int seed, int base)
+{
+    int i, num_words, num_same;
+    int *words;
+
+    words = (int *)buf;
+    num_words = buf_size / (int)sizeof(int);
+    num_same = 0;
+    i = 0;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static const uint32_t lane_offsets[4] = {0, 1, 2, 3};
+    uint32x4_t vseed, vindex, vstep, vmask, vcount;
+    uint64x2_t vcount64;
+
+    /* Compare four words per iteration, accumulating one count per matching
+     * lane, and fold the lane counts together at the end. */
+    vseed = vdupq_n_u32(seed);
+    vindex = vaddq_u32(vdupq_n_u32(base), vld1q_u32(lane_offsets));
+    vstep = vdupq_n_u32(4);
+    vcount = vdupq_n_u32(0);
+    for (; i + 4 <= num_words; i += 4)
+    {
+        vmask = vceqq_u32(vld1q_u32((uint32_t *)&words[i]),
+                          veorq_u32(vseed, vindex));
+        vcount = vaddq_u32(vcount, vshrq_n_u32(vmask, 31));
+        vindex = vaddq_u32(vindex, vstep);
+    }
+    vcount64 = vpaddlq_u32(vcount);
+    num_same = vgetq_lane_u64(vcount64, 0) + vgetq_lane_u64(vcount64, 1);
+#endif
+
+    for (; i < num_words; i++)
+    {
+        if (words[i] == (seed ^ (base + i))) {
+            num_same += 1;
+        }
+    }
+
+    // Count any leftover bytes if the size is not word aligned
+    for (i = 0; i < buf_size % (int)sizeof(int); i++)
+    {
+        if (buf[num_words * sizeof(int) + i] ==
+                (char)(seed ^ (base + num_words + i))) {
+            num_same += 1;
+        }
+    }
+
+    return num_same;
+}
+
 /*----------------------------------------------------------------------------
  * File Operation Utilities
  *----------------------------------------------------------------------------*/
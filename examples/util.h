@@ -18,6 +18,12 @@ int parse_double(char option, char *arg_str, double *data);
 int parse_resolution(char option, char *arg_str, int *height, int *width,
         int *depth);
 
+/* Test pattern utilities. Word i of the buffer holds seed ^ (base + i).
+ * These are NEON vectorized on ARM cores with the Advanced SIMD extension. */
+void pattern_fill(char *buf, int buf_size, int seed, int base);
+int pattern_check(char *buf, int buf_size, int seed, int base);
+int pattern_count_matches(char *buf, int buf_size, int seed, int base);
+
 // File operation utilities
 int robust_read(int fd, char *buf, int buf_size);
 int robust_write(int fd, char *buf, int buf_size);
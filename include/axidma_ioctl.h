@@ -100,12 +100,65 @@ struct axidma_transaction {
     void *buf;                      // The buffer used for the transaction
     size_t buf_len;                 // The length of the buffer
 
+    /* Indicates that the transfer should be completed by busy-polling the
+     * engine from the submitting CPU, rather than sleeping until the
+     * completion callback runs. Polled transfers are always blocking. This
+     * saves the sleep/wakeup round trip, which dominates the cost of small
+     * transfers, and only applies to normal DMA (not VDMA) channels. */
+    bool poll;
+
+    /* A pre-resolved buffer handle from AXIDMA_GET_BUFFER_HANDLE, or 0 if the
+     * buffer is named by `buf`. When a handle is given, `buf` is instead
+     * interpreted as a byte offset into the handle's buffer. */
+    int buf_handle;
+
+    /* The timeout for a blocking transfer in milliseconds, or 0 to use the
+     * driver's default of 10 seconds. A blocking transfer that does not
+     * complete within the timeout fails with ETIME, so latency-sensitive
+     * callers can bound a stalled transfer at their own deadline instead of
+     * the driver's constant. Ignored for non-blocking transfers. */
+    int timeout_ms;
+
+    /* Output: the id assigned to the submitted transfer. The id matches the
+     * cookie reported in the completion ring, so several transfers can be
+     * kept in flight on a channel and told apart as they complete. */
+    int transfer_id;
+
     // Kept as a union for extend ability.
     union {
         struct axidma_video_frame frame;    // Frame information for VDMA.
     };
 };
 
+struct axidma_buffer_handle {
+    void *user_addr;                // User virtual address of the buffer
+    int handle;                     // The handle assigned by the driver
+};
+
+// A single contiguous segment of a vectored (scatter-gather) transaction
+struct axidma_iovec {
+    void *buf;                      // The buffer for this segment
+    size_t len;                     // The length of this segment in bytes
+};
+
+struct axidma_transaction_vec {
+    bool wait;                      // Indicates if the call is blocking
+    int channel_id;                 // The id of the DMA channel to use
+    int icount;                     // The number of entries in the iov array
+    struct axidma_iovec *iov;       // The segments used for the transaction
+};
+
+struct axidma_eventfd {
+    int channel_id;                 // The id of the DMA channel
+    int fd;                         // The eventfd file descriptor (-1 clears)
+};
+
+struct axidma_batch_transaction {
+    bool wait;                      // Indicates if the call is blocking
+    int num_trans;                  // The number of transactions in the array
+    struct axidma_transaction *trans;   // The transactions to submit
+};
+
 struct axidma_inout_transaction {
     bool wait;                      // Indicates if the call is blocking
     int tx_channel_id;              // The id of the transmit DMA channel
@@ -125,6 +178,133 @@ struct axidma_video_transaction {
     struct axidma_video_frame frame;        // Information about the frame
 };
 
+struct axidma_stream {
+    int channel_id;                 // The id of the DMA channel to stream on
+    void *buf;                      // The ring buffer backing the stream
+    size_t buf_len;                 // The total length of the ring buffer
+    int num_periods;                // The number of slots the ring is cut into
+};
+
+struct axidma_coalesce {
+    int channel_id;                 // The id of the DMA channel to configure
+    int coalesce;                   // Completions per interrupt (1 to 255)
+    int delay;                      // Delay timer for partial batches (0-255)
+};
+
+struct axidma_chan_stats {
+    int channel_id;                 // The id of the DMA channel to query
+    unsigned long long submitted;   // Transfers submitted to the engine
+    unsigned long long completed;   // Transfers the engine has completed
+    unsigned long long bytes;       // Bytes moved by completed transfers
+    unsigned long long errors;      // Transfers that failed
+    unsigned long long timeouts;    // Transfers that timed out
+    unsigned long long latency_ns;  // Cumulative submit-to-completion time
+};
+
+struct axidma_sync {
+    void *buf;                      // The start of the range to synchronize
+    size_t len;                     // The length of the range in bytes
+};
+
+/* Lifecycle timestamps of a completed transfer, in nanoseconds on the
+ * kernel's monotonic clock. */
+struct axidma_transfer_times {
+    int channel_id;                 // The id of the DMA channel to query
+    int transfer_id;                // Transfer the timestamps belong to
+    unsigned long long submit_ns;   // Transfer submitted by the ioctl
+    unsigned long long prep_ns;     // Descriptor chain prepared
+    unsigned long long issue_ns;    // Issued to the hardware (0 for batches)
+    unsigned long long complete_ns; // Hardware completion callback ran
+    unsigned long long notify_ns;   // Completion delivery finished
+};
+
+/* A pre-prepared transfer template, created once and triggered repeatedly
+ * for transfers that reuse the same channel, buffer, and length. */
+struct axidma_template {
+    int channel_id;                 // The id of the DMA channel to use
+    void *buf;                      // The buffer used for the transfers
+    size_t buf_len;                 // The length of the buffer
+    int buf_handle;                 // Pre-resolved buffer handle (0 = none)
+    int template_id;                // Output: id assigned to the template
+};
+
+struct axidma_trigger {
+    int template_id;                // The id of the template to trigger
+    bool wait;                      // Indicates if the call is blocking
+    int timeout_ms;                 // Timeout for a blocking trigger (0=default)
+    int transfer_id;                // Output: id assigned to the transfer
+};
+
+struct axidma_frame_sel {
+    int channel_id;                 // The id of the VDMA channel
+    int frame_index;                // The frame to park on (negative unparks)
+};
+
+struct axidma_cancel {
+    int channel_id;                 // The id of the DMA channel
+    int transfer_id;                // The id of the transfer to cancel
+};
+
+struct axidma_stream_slot {
+    int channel_id;                 // The id of the streaming DMA channel
+    bool wait;                      // Indicates if the call is blocking
+    int slot;                       // The index of the filled slot (-1 if none)
+    unsigned long dropped;          // Slots overwritten before consumption
+};
+
+/*----------------------------------------------------------------------------
+ * Completion Ring Definitions
+ *----------------------------------------------------------------------------*/
+
+/* The mmap offset used to map the completion ring into user space. Normal DMA
+ * buffer allocations always use an offset of zero, so this magic offset can
+ * never collide with one. */
+#define AXIDMA_CQ_RING_OFFSET           0x70000000UL
+
+/* The mmap offset used to request a cached DMA buffer allocation. Buffers
+ * mapped at this magic offset are backed by ordinary cached pages with a
+ * streaming DMA mapping, rather than uncached coherent memory, and must be
+ * synchronized with the AXIDMA_SYNC_FOR_* ioctls around each transfer. */
+#define AXIDMA_CACHED_BUF_OFFSET        0x60000000UL
+
+// The number of entries in the completion ring (must be a power of two)
+#define AXIDMA_CQ_NUM_ENTRIES           128
+
+/**
+ * A single completion record in the shared completion ring.
+ *
+ * The driver writes one record into the ring for every completed transaction
+ * while the ring is mapped, carrying the channel the transaction completed
+ * on, its DMA engine cookie, its completion status (0 on success), and the
+ * kernel monotonic timestamp of the completion in nanoseconds.
+ **/
+struct axidma_cq_entry {
+    unsigned int channel_id;        ///< The channel the transaction used.
+    int cookie;                     ///< The DMA engine cookie.
+    int status;                     ///< The completion status (0 on success).
+    unsigned int pad;               ///< Reserved padding field.
+    unsigned long long timestamp;   ///< Completion time (CLOCK_MONOTONIC ns).
+};
+
+/**
+ * The shared completion ring, mapped at #AXIDMA_CQ_RING_OFFSET.
+ *
+ * This is a single-page ring buffer shared between the driver and user space.
+ * The driver is the producer: it appends a record and then publishes it with
+ * a release store to `tail`. User space is the consumer: it observes new
+ * records with an acquire load of `tail`, and frees slots with a release
+ * store to `head`. Records that would overflow the ring are dropped and
+ * counted in `dropped`. This allows completions to be reaped with no system
+ * calls at all.
+ **/
+struct axidma_cq_ring {
+    unsigned int head;              ///< Consumer index, written by user space.
+    unsigned int tail;              ///< Producer index, written by the driver.
+    unsigned int num_entries;       ///< The number of entries in the ring.
+    unsigned int dropped;           ///< Completions dropped on ring overflow.
+    struct axidma_cq_entry entries[];   ///< The completion records.
+};
+
 /*----------------------------------------------------------------------------
  * IOCTL Interface
  *----------------------------------------------------------------------------*/
@@ -133,7 +313,7 @@ struct axidma_video_transaction {
 #define AXIDMA_IOCTL_MAGIC              'W'
 
 // The number of IOCTL's implemented, used for verification
-#define AXIDMA_NUM_IOCTLS               10
+#define AXIDMA_NUM_IOCTLS               34
 
 /**
  * Returns the number of available DMA channels in the system.
@@ -216,6 +396,10 @@ struct axidma_video_transaction {
  * an IOCTL. This will return a file descriptor, which the user must pass into
  * this function, along with the virtual address in userspace.
  *
+ * The buffer does not need to be physically contiguous. A buffer spanning
+ * several physical segments is walked by the DMA engine as a single
+ * descriptor chain, so transfers use it in place with no staging copy.
+ *
  * Inputs:
  *  - fd - File descriptor corresponding to the DMA buffer share.
  *  - size - The size of the DMA buffer in bytes.
@@ -236,11 +420,18 @@ struct axidma_video_transaction {
  * call to mmap with the AXI DMA device. Also, the buffer must be able to hold
  * at least `buf_len` bytes.
  *
+ * Several transfers may be outstanding on a channel at once; each submission
+ * is assigned a transfer id that is reported back through the structure, and
+ * matches the cookie in the shared completion ring.
+ *
  * Inputs:
  *  - wait - Indicates if the call should be blocking or non-blocking
  *  - channel_id - The id for the channel you want receive data over.
  *  - buf - The address of the buffer you want to receive the data in.
  *  - buf_len - The number of bytes to receive.
+ *
+ * Outputs:
+ *  - transfer_id - The id assigned to the submitted transfer.
  **/
 #define AXIDMA_DMA_READ                 _IOR(AXIDMA_IOCTL_MAGIC, 4, \
                                              struct axidma_transaction)
@@ -257,11 +448,18 @@ struct axidma_video_transaction {
  * call to mmap with the AXI DMA device. Also, the buffer must be able to hold
  * at least `buf_len` bytes.
  *
+ * Several transfers may be outstanding on a channel at once; each submission
+ * is assigned a transfer id that is reported back through the structure, and
+ * matches the cookie in the shared completion ring.
+ *
  * Inputs:
  *  - wait - Indicates if the call should be blocking or non-blocking
  *  - channel_id - The id for the channel you want to send data over.
  *  - buf - The address of the data you want to send.
  *  - buf_len - The number of bytes to send.
+ *
+ * Outputs:
+ *  - transfer_id - The id assigned to the submitted transfer.
  **/
 #define AXIDMA_DMA_WRITE                _IOR(AXIDMA_IOCTL_MAGIC, 5, \
                                              struct axidma_transaction)
@@ -377,4 +575,521 @@ struct axidma_video_transaction {
  **/
 #define AXIDMA_UNREGISTER_BUFFER        _IO(AXIDMA_IOCTL_MAGIC, 10)
 
+/**
+ * Receives data from the logic fabric into several scattered buffers.
+ *
+ * This function behaves identically to AXIDMA_DMA_READ, except that the
+ * received data is delivered into an arbitrary number of segments instead of
+ * a single contiguous buffer. The segments are walked by the DMA engine in a
+ * single descriptor chain, so no intermediate copies are required to
+ * assemble fragmented data.
+ *
+ * Each segment must be within an address range that was allocated by a call
+ * to mmap with the AXI DMA device, and must be able to hold at least `len`
+ * bytes. The input array of segments must be a memory location that holds
+ * `icount` axidma_iovec structures.
+ *
+ * Inputs:
+ *  - wait - Indicates if the call should be blocking or non-blocking
+ *  - channel_id - The id for the channel you want receive data over.
+ *  - icount - The number of segments in the iov array.
+ *  - iov - An array of the buffer segments to receive the data in.
+ **/
+#define AXIDMA_DMA_READV                _IOR(AXIDMA_IOCTL_MAGIC, 11, \
+                                             struct axidma_transaction_vec)
+
+/**
+ * Sends data from several scattered buffers to the logic fabric.
+ *
+ * This function behaves identically to AXIDMA_DMA_WRITE, except that the
+ * transmitted data is gathered from an arbitrary number of segments instead
+ * of a single contiguous buffer. The segments are walked by the DMA engine in
+ * a single descriptor chain, so no intermediate copies are required to stage
+ * fragmented data.
+ *
+ * Each segment must be within an address range that was allocated by a call
+ * to mmap with the AXI DMA device, and must be able to hold at least `len`
+ * bytes. The input array of segments must be a memory location that holds
+ * `icount` axidma_iovec structures.
+ *
+ * Inputs:
+ *  - wait - Indicates if the call should be blocking or non-blocking
+ *  - channel_id - The id for the channel you want to send data over.
+ *  - icount - The number of segments in the iov array.
+ *  - iov - An array of the buffer segments containing the data to send.
+ **/
+#define AXIDMA_DMA_WRITEV               _IOR(AXIDMA_IOCTL_MAGIC, 12, \
+                                             struct axidma_transaction_vec)
+
+/**
+ * Submits a batch of transactions to the DMA engine in a single call.
+ *
+ * This function prepares and submits all of the given transactions to their
+ * DMA channels, and only then starts the engine, with a single issue per
+ * channel. Compared to one AXIDMA_DMA_READ/AXIDMA_DMA_WRITE ioctl per
+ * transaction, this amortizes both the system call and the DMA engine
+ * submission overhead across the whole batch, which matters for small
+ * transfer sizes.
+ *
+ * The direction of each transaction is determined by its channel, so read and
+ * write transactions can be freely mixed in one batch. The per-transaction
+ * `wait` field is ignored; if the batch-level `wait` flag is set, the call
+ * blocks until every transaction in the batch has completed. The buffers
+ * follow the same rules as for AXIDMA_DMA_READ. Batches are restricted to
+ * normal DMA channels (no VDMA).
+ *
+ * Inputs:
+ *  - wait - Indicates if the call should be blocking or non-blocking
+ *  - num_trans - The number of transactions in the trans array.
+ *  - trans - An array of the transactions to submit.
+ **/
+#define AXIDMA_DMA_SUBMIT_BATCH         _IOR(AXIDMA_IOCTL_MAGIC, 13, \
+                                             struct axidma_batch_transaction)
+
+/**
+ * Registers an eventfd to be signaled when DMA transactions complete on the
+ * given channel.
+ *
+ * This is an alternative to AXIDMA_SET_DMA_SIGNAL for asynchronous
+ * completion notification. When an eventfd is registered for a channel, the
+ * driver signals the eventfd on each completed transaction instead of
+ * delivering a POSIX real-time signal to the process. This allows completions
+ * to be waited on with select/poll/epoll alongside other file descriptors,
+ * and avoids the serialization cost of signal delivery in multi-threaded
+ * programs.
+ *
+ * The eventfd registration is per-channel. Passing a fd of -1 unregisters the
+ * eventfd for the channel, reverting it to signal-based notification.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to register the eventfd for.
+ *  - fd - The eventfd file descriptor, or -1 to unregister.
+ **/
+#define AXIDMA_SET_DMA_EVENTFD          _IOR(AXIDMA_IOCTL_MAGIC, 14, \
+                                             struct axidma_eventfd)
+
+/**
+ * Returns a pre-resolved handle for the DMA buffer at the given address.
+ *
+ * This function resolves the given user virtual address to its DMA address
+ * once, up front, and stores the result in a driver-side table. The returned
+ * handle can then be placed in the `buf_handle` field of an
+ * axidma_transaction, in which case the transfer skips the address
+ * translation entirely, and the `buf` field carries the byte offset into the
+ * handle's buffer. This is worthwhile for hot buffers that are reused across
+ * many transfers.
+ *
+ * The address must be within an address range that was allocated by a call
+ * to mmap with the AXI DMA device, or registered with
+ * AXIDMA_REGISTER_BUFFER. Handles are a limited resource; if the driver's
+ * handle table is full, this call fails. A handle is invalidated when its
+ * underlying buffer is freed or unregistered.
+ *
+ * Inputs:
+ *  - user_addr - The user virtual address of the buffer.
+ *
+ * Outputs:
+ *  - handle - The handle assigned to the buffer (always positive).
+ **/
+#define AXIDMA_GET_BUFFER_HANDLE        _IOR(AXIDMA_IOCTL_MAGIC, 15, \
+                                             struct axidma_buffer_handle)
+
+/**
+ * Claims exclusive ownership of the given DMA channel for this open file.
+ *
+ * The device supports concurrent opens, so independent processes can each
+ * drive their own channels directly, without proxying their transfers through
+ * a single broker process. Each open file carries its own namespace of DMA
+ * buffers, and channels are shared between the opens through claiming: once a
+ * file has claimed a channel, transfers and stops on that channel from any
+ * other open file fail with EBUSY.
+ *
+ * A channel that has not been claimed by anyone remains usable from every
+ * open file, preserving the single-process behavior. Claims are released
+ * automatically when the owning file is closed. Claiming a channel this file
+ * already owns is a no-op.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to claim, passed as the argument.
+ **/
+#define AXIDMA_CLAIM_CHANNEL            _IO(AXIDMA_IOCTL_MAGIC, 16)
+
+/**
+ * Receives data from the logic fabric into arbitrary user memory.
+ *
+ * This function behaves identically to AXIDMA_DMA_READ, except that the
+ * buffer may be any readable/writable range of the calling process's memory,
+ * rather than one allocated by a call to mmap with the AXI DMA device. The
+ * driver pins the buffer's pages in place for the duration of the transfer
+ * and builds a scatter-gather chain over them, so the data lands in place
+ * with no staging copy through a dedicated DMA buffer.
+ *
+ * Pinning and unpinning the pages costs more per transfer than the
+ * translation of a pre-allocated DMA buffer, so this is intended for bulk
+ * transfers where eliminating the staging memcpy dominates that cost.
+ *
+ * Inputs:
+ *  - wait - Indicates if the call should be blocking or non-blocking
+ *  - channel_id - The id for the channel you want receive data over.
+ *  - buf - The address of the buffer you want to receive the data in.
+ *  - buf_len - The number of bytes to receive.
+ *
+ * Outputs:
+ *  - transfer_id - The id assigned to the submitted transfer.
+ **/
+#define AXIDMA_DMA_READ_USER            _IOR(AXIDMA_IOCTL_MAGIC, 17, \
+                                             struct axidma_transaction)
+
+/**
+ * Sends data from arbitrary user memory to the logic fabric.
+ *
+ * This function behaves identically to AXIDMA_DMA_WRITE, except that the
+ * buffer may be any readable range of the calling process's memory, rather
+ * than one allocated by a call to mmap with the AXI DMA device. The driver
+ * pins the buffer's pages in place for the duration of the transfer and
+ * builds a scatter-gather chain over them, so the data is sent in place with
+ * no staging copy through a dedicated DMA buffer.
+ *
+ * Pinning and unpinning the pages costs more per transfer than the
+ * translation of a pre-allocated DMA buffer, so this is intended for bulk
+ * transfers where eliminating the staging memcpy dominates that cost.
+ *
+ * Inputs:
+ *  - wait - Indicates if the call should be blocking or non-blocking
+ *  - channel_id - The id for the channel you want to send data over.
+ *  - buf - The address of the data you want to send.
+ *  - buf_len - The number of bytes to send.
+ *
+ * Outputs:
+ *  - transfer_id - The id assigned to the submitted transfer.
+ **/
+#define AXIDMA_DMA_WRITE_USER           _IOR(AXIDMA_IOCTL_MAGIC, 18, \
+                                             struct axidma_transaction)
+
+/**
+ * Starts a cyclic streaming transfer on a DMA channel.
+ *
+ * Cuts the given ring buffer into num_periods equally sized slots, and
+ * starts a cyclic transfer that the engine services continuously, wrapping
+ * back to the first slot after the last one with no gap in between. The
+ * driver advances a head index each time the engine finishes a slot; user
+ * space consumes filled slots with AXIDMA_STREAM_NEXT. The stream runs until
+ * it is stopped with AXIDMA_STREAM_STOP.
+ *
+ * The buffer must come from an mmap call with the AXI DMA device, its length
+ * must be a multiple of num_periods, and the channel must be a normal DMA
+ * (not VDMA) channel. Only one stream can be active per channel, and while
+ * one is, one-shot transfers must not be submitted on the channel.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to stream on.
+ *  - buf - The address of the ring buffer backing the stream.
+ *  - buf_len - The total length of the ring buffer in bytes.
+ *  - num_periods - The number of slots to cut the ring buffer into.
+ **/
+#define AXIDMA_STREAM_START             _IOR(AXIDMA_IOCTL_MAGIC, 19, \
+                                             struct axidma_stream)
+
+/**
+ * Consumes the next filled slot of a cyclic streaming transfer.
+ *
+ * Returns the index of the oldest ring slot that the engine has filled and
+ * user space has not yet consumed. If the call is blocking, it waits until
+ * the engine fills a slot; otherwise a slot index of -1 reports that no slot
+ * is ready. If user space falls behind by more than a full ring, the oldest
+ * unconsumed slots have been overwritten; they are skipped and counted in
+ * the dropped field.
+ *
+ * Inputs:
+ *  - channel_id - The id of the streaming channel.
+ *  - wait - Indicates if the call should be blocking or non-blocking.
+ *
+ * Outputs:
+ *  - slot - The index of the filled slot, or -1 if none is ready.
+ *  - dropped - The number of slots overwritten before they were consumed.
+ **/
+#define AXIDMA_STREAM_NEXT              _IOR(AXIDMA_IOCTL_MAGIC, 20, \
+                                             struct axidma_stream_slot)
+
+/**
+ * Stops the cyclic streaming transfer on a DMA channel.
+ *
+ * Terminates the stream started with AXIDMA_STREAM_START, and wakes up any
+ * blocked AXIDMA_STREAM_NEXT callers. The channel can then be used for
+ * one-shot transfers or a new stream.
+ *
+ * Inputs:
+ *  - channel_id - The id of the streaming channel (passed directly).
+ **/
+#define AXIDMA_STREAM_STOP              _IO(AXIDMA_IOCTL_MAGIC, 21)
+
+/**
+ * Reads the accumulated statistics for a DMA channel.
+ *
+ * The driver counts every transfer submitted and completed on each channel,
+ * along with the bytes moved, the transfers that failed or timed out, and
+ * the cumulative submit-to-completion latency in nanoseconds. Dividing
+ * latency_ns by completed gives the mean per-transfer latency. The counters
+ * accumulate from module load, and are also readable from debugfs at
+ * axidma/stats. Reading them does not perturb in-flight transfers.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to query.
+ *
+ * Outputs:
+ *  - submitted - The number of transfers submitted to the engine.
+ *  - completed - The number of transfers the engine has completed.
+ *  - bytes - The number of bytes moved by completed transfers.
+ *  - errors - The number of transfers that failed.
+ *  - timeouts - The number of transfers that timed out.
+ *  - latency_ns - The cumulative submit-to-completion time in nanoseconds.
+ **/
+#define AXIDMA_GET_CHANNEL_STATS        _IOR(AXIDMA_IOCTL_MAGIC, 22, \
+                                             struct axidma_chan_stats)
+
+/**
+ * Configures interrupt coalescing for a DMA channel.
+ *
+ * Sets the number of completed transfers the engine accumulates before
+ * raising an interrupt, and the delay timer that flushes a partial batch so
+ * completions are never held back indefinitely. A coalesce count of 16 on a
+ * bulk channel cuts the interrupt load 16x; latency-sensitive channels
+ * should stay at the default of 1 interrupt per completion.
+ *
+ * The settings take effect from the next transfer prepared on the channel.
+ * For plain DMA channels, the engine-level configuration is only available
+ * on Xilinx vendor kernels that export it; elsewhere the settings still
+ * apply to VDMA channels.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to configure.
+ *  - coalesce - The number of completions per interrupt, from 1 to 255.
+ *  - delay - The delay timer for flushing partial batches, from 0 (disabled)
+ *            to 255, in units of 125 * clock period.
+ **/
+#define AXIDMA_SET_COALESCING           _IOR(AXIDMA_IOCTL_MAGIC, 23, \
+                                             struct axidma_coalesce)
+
+/**
+ * Hands ownership of a cached DMA buffer range to the processor.
+ *
+ * Buffers mapped at AXIDMA_CACHED_BUF_OFFSET are backed by ordinary cached
+ * pages, so the processor's caches must be synchronized with memory around
+ * each transfer. This call invalidates the given range in the caches, and
+ * must be made after a receive transfer completes, before the processor reads
+ * the received data. The cost is proportional to the range's length, so only
+ * the bytes actually accessed should be synchronized.
+ *
+ * Buffers from a plain (coherent) mmap allocation never need synchronization;
+ * for them this call is a no-op.
+ *
+ * Inputs:
+ *  - buf - The start of the buffer range to synchronize.
+ *  - len - The length of the range in bytes.
+ **/
+#define AXIDMA_SYNC_FOR_CPU             _IOR(AXIDMA_IOCTL_MAGIC, 24, \
+                                             struct axidma_sync)
+
+/**
+ * Hands ownership of a cached DMA buffer range back to the device.
+ *
+ * This is the counterpart of AXIDMA_SYNC_FOR_CPU: it writes back any dirty
+ * cache lines covering the given range, and must be made after the processor
+ * finishes writing data to a cached buffer, before the transmit transfer that
+ * sends it is submitted. The cost is proportional to the range's length, so
+ * only the bytes actually written should be synchronized.
+ *
+ * Buffers from a plain (coherent) mmap allocation never need synchronization;
+ * for them this call is a no-op.
+ *
+ * Inputs:
+ *  - buf - The start of the buffer range to synchronize.
+ *  - len - The length of the range in bytes.
+ **/
+#define AXIDMA_SYNC_FOR_DEVICE          _IOR(AXIDMA_IOCTL_MAGIC, 25, \
+                                             struct axidma_sync)
+
+/**
+ * Cancels a single in-flight transfer on a channel.
+ *
+ * Abandons the transfer with the given id without disturbing anything else
+ * queued on the channel, unlike AXIDMA_STOP_DMA_CHANNEL, which terminates
+ * every in-flight transfer at once. The DMA engine cannot abort a single
+ * descriptor in place, so the transfer is detached instead: a thread blocked
+ * waiting on it returns ECANCELED immediately, and its eventual completion
+ * is retired silently, never reaching the completion ring, eventfd, or
+ * signal notification paths. Together with the per-transfer timeout_ms
+ * field, this bounds the tail latency of a stalled transfer at the
+ * application's deadline.
+ *
+ * Returns -ENOENT if the transfer is not in flight on the channel, which
+ * includes transfers that have already completed.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel the transfer was submitted on.
+ *  - transfer_id - The id reported when the transfer was submitted.
+ **/
+#define AXIDMA_CANCEL_TRANSFER          _IOR(AXIDMA_IOCTL_MAGIC, 26, \
+                                             struct axidma_cancel)
+
+/**
+ * Switches the frame buffer a running VDMA transfer scans out.
+ *
+ * Parks the VDMA engine on the frame buffer with the given index, chosen
+ * from the frame buffers of the video transfer running on the channel. The
+ * engine finishes the frame it is currently processing before switching, so
+ * the change is tear-free, and the transfer keeps running throughout --
+ * unlike a stop/start cycle, which blanks the display for several frames.
+ * This is the building block for double and triple buffering: render into an
+ * off-screen frame buffer, then park the display on it.
+ *
+ * A negative frame index releases the park, resuming circulation through all
+ * of the transfer's frame buffers. Returns -EBUSY if no video transfer is
+ * running on the channel.
+ *
+ * Inputs:
+ *  - channel_id - The id of the VDMA channel to switch.
+ *  - frame_index - The index of the frame buffer to park on, or a negative
+ *                  value to resume circulating through all frames.
+ **/
+#define AXIDMA_VIDEO_SET_FRAME          _IOR(AXIDMA_IOCTL_MAGIC, 27, \
+                                             struct axidma_frame_sel)
+
+/**
+ * Acquires the DMA engine backing the given channel ahead of its first use.
+ *
+ * The driver does not request any engines from the DMA subsystem at module
+ * load; each channel's engine is acquired on the first operation that drives
+ * it, so a deployment that uses a few of the device tree's channels never
+ * ties up the rest, and they remain available to other kernel consumers.
+ * This ioctl performs that acquisition explicitly, so the one-time cost is
+ * paid at setup instead of on the first transfer, and so a busy engine is
+ * discovered before the data path depends on it.
+ *
+ * Acquiring a channel that is already acquired is a no-op. Returns -ENODEV
+ * if the engine is held by another kernel consumer.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to acquire, passed as the argument.
+ **/
+#define AXIDMA_ACQUIRE_CHANNEL          _IO(AXIDMA_IOCTL_MAGIC, 28)
+
+/**
+ * Releases the DMA engine backing the given channel to the DMA subsystem.
+ *
+ * Gives the channel's engine back once this process is done with it, making
+ * it available to other kernel consumers without unloading the module. The
+ * channel remains valid, and is re-acquired automatically if it is used
+ * again. Any transfers still in flight on the channel are terminated, as
+ * with AXIDMA_STOP_DMA_CHANNEL.
+ *
+ * Releasing a channel that was never acquired is a no-op. Returns -EBUSY if
+ * another open file has claimed the channel.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to release, passed as the argument.
+ **/
+#define AXIDMA_RELEASE_CHANNEL          _IO(AXIDMA_IOCTL_MAGIC, 29)
+
+/**
+ * Returns the lifecycle timestamps of the channel's last completed transfer.
+ *
+ * The driver timestamps each transfer as it moves through its lifecycle
+ * stages -- submission, descriptor preparation, issue to the hardware, the
+ * hardware completion callback, and completion delivery -- and keeps the
+ * timestamps of the most recently completed transfer on each channel. This
+ * ioctl reads them out, so a latency spike can be attributed to the correct
+ * layer from user space, without debug rebuilds. The same stages also fire
+ * ftrace tracepoints (the axidma trace system) for system-wide correlation.
+ *
+ * The timestamps are nanoseconds on the kernel's monotonic clock. The
+ * returned transfer_id identifies the transfer they belong to, so a caller
+ * that just completed a blocking transfer can confirm the times are its own.
+ * The issue timestamp is zero for transfers submitted as part of a batch.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel to query.
+ *
+ * Outputs:
+ *  - transfer_id - The id of the transfer the timestamps belong to.
+ *  - submit_ns - When the transfer path was entered.
+ *  - prep_ns - When the engine's descriptor chain was prepared.
+ *  - issue_ns - When the transfer was issued to the hardware.
+ *  - complete_ns - When the hardware completion callback ran.
+ *  - notify_ns - When the completion delivery finished.
+ **/
+#define AXIDMA_GET_TRANSFER_TIMES       _IOR(AXIDMA_IOCTL_MAGIC, 30, \
+                                             struct axidma_transfer_times)
+
+/**
+ * Creates a pre-prepared transfer template for the given buffer and channel.
+ *
+ * A workload that performs the same transfer repeatedly -- same channel,
+ * buffer, and length -- pays for the address translation and descriptor
+ * chain construction on every submission. A template does that work once, up
+ * front: the buffer's scatter-gather list is built and kept when the
+ * template is created, and on engines that support the DMA subsystem's
+ * descriptor reuse facility, the prepared descriptor itself is kept as well.
+ * The template is then resubmitted with AXIDMA_DMA_TRIGGER, which skips the
+ * per-iteration preparation cost entirely.
+ *
+ * The buffer follows the same rules as for AXIDMA_DMA_READ, or may be named
+ * by a pre-resolved buffer handle with an offset, as in the transaction
+ * ioctls. The channel must be a normal DMA (not VDMA) channel. Templates are
+ * a limited per-open-file resource, and must be destroyed with
+ * AXIDMA_DESTROY_TEMPLATE before the channel's engine is released with
+ * AXIDMA_RELEASE_CHANNEL.
+ *
+ * Inputs:
+ *  - channel_id - The id of the channel the template is bound to.
+ *  - buf - The address of the buffer the template transfers.
+ *  - buf_len - The number of bytes the template transfers.
+ *  - buf_handle - A pre-resolved buffer handle, or 0 if `buf` is an address.
+ *
+ * Outputs:
+ *  - template_id - The id assigned to the template (always positive).
+ **/
+#define AXIDMA_CREATE_TEMPLATE          _IOR(AXIDMA_IOCTL_MAGIC, 31, \
+                                             struct axidma_template)
+
+/**
+ * Triggers a transfer from a pre-prepared template.
+ *
+ * Resubmits the template created with AXIDMA_CREATE_TEMPLATE to its channel.
+ * On engines that support descriptor reuse, the pre-prepared descriptor is
+ * handed straight back to the engine; elsewhere the descriptor is
+ * re-prepared from the template's cached scatter-gather list, which still
+ * skips the address translation and list construction. The call otherwise
+ * behaves as AXIDMA_DMA_READ/AXIDMA_DMA_WRITE: it can block or not, the
+ * completion reaches the usual notification paths, and the assigned transfer
+ * id is reported back.
+ *
+ * A reused descriptor can only have one submission in flight at a time;
+ * triggering a template whose previous transfer has not yet completed fails
+ * with EBUSY on such engines.
+ *
+ * Inputs:
+ *  - template_id - The id of the template to trigger.
+ *  - wait - Indicates if the call should be blocking or non-blocking.
+ *  - timeout_ms - Timeout for a blocking trigger, or 0 for the default.
+ *
+ * Outputs:
+ *  - transfer_id - The id assigned to the submitted transfer.
+ **/
+#define AXIDMA_DMA_TRIGGER              _IOR(AXIDMA_IOCTL_MAGIC, 32, \
+                                             struct axidma_trigger)
+
+/**
+ * Destroys a pre-prepared transfer template.
+ *
+ * Frees the template's cached scatter-gather list, and releases its reusable
+ * descriptor back to the engine if one was kept. Returns -EBUSY if the
+ * template's descriptor is still in flight. Any templates remaining when the
+ * file is closed are destroyed automatically.
+ *
+ * Inputs:
+ *  - template_id - The id of the template to destroy, passed as the argument.
+ **/
+#define AXIDMA_DESTROY_TEMPLATE         _IO(AXIDMA_IOCTL_MAGIC, 33)
+
 #endif /* AXIDMA_IOCTL_H_ */
@@ -39,6 +39,38 @@ typedef struct array {
     int *data;      ///< Pointer to the memory buffer for the array
 } array_t;
 
+/**
+ * The struct representing a DMA buffer pool.
+ *
+ * This is an opaque type to the end user, so it can only be used as a pointer
+ * or handle.
+ **/
+struct axidma_pool;
+
+/**
+ * Type definition for a DMA buffer pool.
+ *
+ * This is a pointer to an opaque struct, so the user cannot access any of the
+ * internal fields.
+ **/
+typedef struct axidma_pool* axidma_pool_t;
+
+/**
+ * Type definition for a ping-pong transfer pipeline.
+ *
+ * This is a pointer to an opaque struct, so the user cannot access any of the
+ * internal fields.
+ **/
+typedef struct axidma_pipeline* axidma_pipeline_t;
+
+/**
+ * A handle to a single DMA channel, opened by #axidma_open_channel.
+ *
+ * This is a pointer to an opaque struct, so the user cannot access any of the
+ * internal fields.
+ **/
+typedef struct axidma_chan_handle* axidma_chan_handle_t;
+
 /**
  * Type definition for a AXI DMA callback function.
  *
@@ -124,6 +156,29 @@ const array_t *axidma_get_vdma_rx(axidma_dev_t dev);
  **/
 void *axidma_malloc(axidma_dev_t dev, size_t size);
 
+/**
+ * Allocates a cached DMA buffer suitable for an AXI DMA device of \p size
+ * bytes.
+ *
+ * Unlike #axidma_malloc, the buffer is backed by ordinary cached pages, so
+ * CPU-side processing of the data (checksums, parsing, pixel operations) runs
+ * at full cache speed instead of the 5-8x slower uncached access of a
+ * coherent buffer. In exchange, the caches must be synchronized with memory
+ * around each transfer: call #axidma_sync_for_cpu after a receive completes
+ * and before reading the data, and #axidma_sync_for_device after writing the
+ * data and before submitting a transmit. The buffer is freed with
+ * #axidma_free as usual.
+ *
+ * Prefer this allocation when the processor touches most of the transferred
+ * bytes; if the buffer is only a staging area that the CPU barely reads,
+ * #axidma_malloc avoids the synchronization calls entirely.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] size The size of the buffer in bytes.
+ * @return The address of buffer on success, NULL on failure.
+ **/
+void *axidma_malloc_cached(axidma_dev_t dev, size_t size);
+
 /**
  * Frees a DMA buffer previously allocated by #axidma_malloc.
  *
@@ -138,6 +193,187 @@ void *axidma_malloc(axidma_dev_t dev, size_t size);
  **/
 void axidma_free(axidma_dev_t dev, void *addr, size_t size);
 
+/**
+ * Hands ownership of a cached DMA buffer range to the processor.
+ *
+ * This invalidates the processor's caches over the given range, so that reads
+ * observe the data the DMA engine wrote to memory. It must be called after a
+ * receive transfer into a buffer from #axidma_malloc_cached completes, before
+ * reading the received data. The cost is proportional to \p len, so
+ * synchronize only the bytes actually read. For buffers from #axidma_malloc
+ * this call is a harmless no-op.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] buf Start of the buffer range to synchronize, within a buffer
+ *                previously allocated by #axidma_malloc_cached.
+ * @param[in] len Length of the range in bytes.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_sync_for_cpu(axidma_dev_t dev, void *buf, size_t len);
+
+/**
+ * Hands ownership of a cached DMA buffer range back to the device.
+ *
+ * This writes dirty cache lines over the given range back to memory, so that
+ * the DMA engine reads the data the processor wrote. It must be called after
+ * writing data into a buffer from #axidma_malloc_cached, before submitting
+ * the transmit transfer that sends it. The cost is proportional to \p len, so
+ * synchronize only the bytes actually written. For buffers from
+ * #axidma_malloc this call is a harmless no-op.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] buf Start of the buffer range to synchronize, within a buffer
+ *                previously allocated by #axidma_malloc_cached.
+ * @param[in] len Length of the range in bytes.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_sync_for_device(axidma_dev_t dev, void *buf, size_t len);
+
+/**
+ * Creates a pool of fixed-size DMA buffers of \p block_size bytes each.
+ *
+ * Allocating a DMA buffer with #axidma_malloc is quite expensive, since every
+ * call is an mmap that reaches into the kernel's coherent allocator. A pool
+ * instead grabs one large DMA region of \p total_size bytes up front, and
+ * sub-allocates fixed-size blocks from it with a lock-free free list, so
+ * steady-state buffer acquisition costs only a few atomic operations. This is
+ * the preferred way to manage many short-lived DMA buffers.
+ *
+ * The block size is rounded up so that the blocks are suitably aligned, and
+ * the pool serves as many blocks as fit in the region. #axidma_pool_alloc and
+ * #axidma_pool_free are safe to call concurrently from multiple threads.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] total_size The size of the underlying DMA region in bytes.
+ * @param[in] block_size The size of each buffer served by the pool in bytes.
+ * @return A handle to the buffer pool on success, NULL on failure.
+ **/
+axidma_pool_t axidma_pool_create(axidma_dev_t dev, size_t total_size,
+        size_t block_size);
+
+/**
+ * Destroys a DMA buffer pool, freeing its underlying DMA region.
+ *
+ * All buffers served by the pool are invalidated by this call, whether or not
+ * they have been returned with #axidma_pool_free.
+ *
+ * @param[in] pool An #axidma_pool_t returned by #axidma_pool_create.
+ **/
+void axidma_pool_destroy(axidma_pool_t pool);
+
+/**
+ * Allocates a fixed-size DMA buffer from the given pool.
+ *
+ * The returned buffer lies within the pool's DMA region, so it can be used
+ * directly in any of the transfer functions, just like a buffer from
+ * #axidma_malloc. This function involves no system calls, and is safe to call
+ * concurrently from multiple threads.
+ *
+ * @param[in] pool An #axidma_pool_t returned by #axidma_pool_create.
+ * @return The address of a buffer on success, NULL if the pool is exhausted.
+ **/
+void *axidma_pool_alloc(axidma_pool_t pool);
+
+/**
+ * Returns a DMA buffer previously allocated by #axidma_pool_alloc to its pool.
+ *
+ * This function will abort if \p addr does not lie on a block boundary within
+ * the pool's DMA region. This function involves no system calls, and is safe
+ * to call concurrently from multiple threads.
+ *
+ * @param[in] pool An #axidma_pool_t returned by #axidma_pool_create.
+ * @param[in] addr Address of the buffer returned by #axidma_pool_alloc.
+ **/
+void axidma_pool_free(axidma_pool_t pool, void *addr);
+
+/**
+ * Creates a ping-pong pipeline of \p num_stages buffer pairs.
+ *
+ * A coupled offload (send input to the accelerator, receive the result) that
+ * uses one buffer pair per #axidma_twoway_transfer call serializes: the
+ * engine idles while the CPU fills the next input and drains the last
+ * result. The pipeline keeps \p num_stages transmit/receive buffer pairs
+ * rotating, so buffer pair k+1 is being filled by the CPU while pair k is in
+ * flight and pair k-1 is being drained. Two stages (double buffering)
+ * already overlap the CPU work with the transfers; more stages absorb
+ * jitter.
+ *
+ * Use the pipeline by repeating: fill the buffer from
+ * #axidma_pipeline_tx_buf, submit it with #axidma_pipeline_submit, and once
+ * the pipeline is primed, drain results with #axidma_pipeline_complete. The
+ * pipeline registers an eventfd on the receive channel for completion
+ * tracking, replacing any eventfd registered there with
+ * #axidma_set_eventfd. This function will abort if either channel is
+ * invalid, or if \p num_stages is less than two.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] tx_channel DMA channel that transmits the input buffers.
+ * @param[in] rx_channel DMA channel that receives the result buffers.
+ * @param[in] buf_size The size of each stage buffer in bytes.
+ * @param[in] num_stages The number of buffer pairs in the pipeline.
+ * @return A handle to the pipeline on success, NULL on failure.
+ **/
+axidma_pipeline_t axidma_pipeline_create(axidma_dev_t dev, int tx_channel,
+        int rx_channel, size_t buf_size, int num_stages);
+
+/**
+ * Destroys a ping-pong pipeline, freeing its buffers.
+ *
+ * Any transfers still in flight are abandoned, so drain the pipeline with
+ * #axidma_pipeline_complete first if their results matter. The eventfd the
+ * pipeline registered on the receive channel is unregistered.
+ *
+ * @param[in] pipeline An #axidma_pipeline_t returned by
+ *                     #axidma_pipeline_create.
+ **/
+void axidma_pipeline_destroy(axidma_pipeline_t pipeline);
+
+/**
+ * Returns the transmit buffer of the next free pipeline stage.
+ *
+ * The CPU fills this buffer with the next input while earlier stages are in
+ * flight, then submits it with #axidma_pipeline_submit. If every stage is in
+ * flight, NULL is returned; draining a result with
+ * #axidma_pipeline_complete frees its stage for filling again.
+ *
+ * @param[in] pipeline An #axidma_pipeline_t returned by
+ *                     #axidma_pipeline_create.
+ * @return The transmit buffer to fill, or NULL if every stage is in flight.
+ **/
+void *axidma_pipeline_tx_buf(axidma_pipeline_t pipeline);
+
+/**
+ * Submits the pipeline stage whose transmit buffer was last handed out.
+ *
+ * This kicks off the stage's transmit and receive transfers asynchronously
+ * and returns immediately; the result is claimed later with
+ * #axidma_pipeline_complete. This function will abort if every stage is
+ * already in flight, or if either length exceeds the stage buffer size.
+ *
+ * @param[in] pipeline An #axidma_pipeline_t returned by
+ *                     #axidma_pipeline_create.
+ * @param[in] tx_len Number of bytes to transmit from the stage's buffer.
+ * @param[in] rx_len Number of bytes to receive into the stage's buffer.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_pipeline_submit(axidma_pipeline_t pipeline, size_t tx_len,
+        size_t rx_len);
+
+/**
+ * Waits for the oldest in-flight pipeline stage and returns its result.
+ *
+ * This function blocks until the stage's receive transfer completes, then
+ * returns the receive buffer holding the result. The buffer contents remain
+ * valid until the stage's turn comes around again, which cannot happen for
+ * at least \p num_stages - 1 further submits.
+ *
+ * @param[in] pipeline An #axidma_pipeline_t returned by
+ *                     #axidma_pipeline_create.
+ * @return The receive buffer of the completed stage, or NULL if no stage is
+ *         in flight or the wait failed.
+ **/
+void *axidma_pipeline_complete(axidma_pipeline_t pipeline);
+
 /**
  * Registers a DMA buffer that was allocated externally, by another driver.
  *
@@ -172,6 +408,138 @@ int axidma_register_buffer(axidma_dev_t dev, int dmabuf_fd, void *user_addr,
  **/
 void axidma_unregister_buffer(axidma_dev_t dev, void *user_addr);
 
+/**
+ * Maps the driver's shared completion ring into the process.
+ *
+ * The completion ring is a single page of memory shared between the driver
+ * and user space. While it is mapped, the driver appends a record for every
+ * completed transaction (channel id, DMA engine cookie, status, and kernel
+ * timestamp), and the process can reap those records with
+ * #axidma_reap_completions without making any system calls. This is the
+ * lowest-latency completion path the device offers.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_setup_completion_ring(axidma_dev_t dev);
+
+/**
+ * Checks if a completion record is pending in the shared completion ring.
+ *
+ * This function does not consume the record, and involves no system calls.
+ * This function will abort if the completion ring has not been mapped with
+ * #axidma_setup_completion_ring.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @return 1 if at least one completion record is pending, 0 otherwise.
+ **/
+int axidma_peek_completion(axidma_dev_t dev);
+
+/**
+ * Reaps pending completion records from the shared completion ring.
+ *
+ * This function copies up to \p max_entries pending records into the given
+ * array and frees their ring slots, all without any system calls. It never
+ * blocks; if no completions are pending it simply returns 0. This function
+ * will abort if the completion ring has not been mapped with
+ * #axidma_setup_completion_ring.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[out] entries An array that can hold at least \p max_entries
+ *                     completion records.
+ * @param[in] max_entries The maximum number of records to reap.
+ * @return The number of records reaped, which may be zero.
+ **/
+int axidma_reap_completions(axidma_dev_t dev, struct axidma_cq_entry *entries,
+        int max_entries);
+
+/**
+ * Claims the given DMA channel for this process's exclusive use.
+ *
+ * The AXI DMA device supports concurrent opens, so independent processes can
+ * each drive their own channels directly. Channels are shared between the
+ * processes through claiming: once this process has claimed a channel,
+ * transfers and stops on it from any other process fail until this process
+ * calls #axidma_destroy or exits. A channel that nobody has claimed remains
+ * usable from every process.
+ *
+ * Each process sees only its own DMA buffers; buffers allocated with
+ * #axidma_malloc or registered with #axidma_register_buffer in one process
+ * cannot be used for transfers in another. This function will abort if the
+ * channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to claim.
+ * @return 0 upon success, a negative number on failure (e.g. if another
+ *         process has already claimed the channel).
+ **/
+int axidma_claim_channel(axidma_dev_t dev, int channel);
+
+/**
+ * Acquires the DMA engine backing the given channel ahead of its first use.
+ *
+ * The driver does not tie up any DMA engines when the module loads; each
+ * channel's engine is acquired from the kernel's DMA subsystem on the first
+ * operation that drives it, so unused channels stay available to other
+ * kernel consumers. This function performs that acquisition explicitly, so
+ * the one-time cost is paid at setup rather than on the first transfer, and
+ * a busy engine is discovered before the data path depends on it.
+ *
+ * Acquiring a channel that is already acquired is a no-op. Note that this is
+ * distinct from #axidma_claim_channel, which arbitrates a channel between
+ * processes; acquisition obtains the underlying engine from the kernel. This
+ * function will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to acquire.
+ * @return 0 upon success, a negative number on failure (e.g. if another
+ *         kernel consumer holds the engine).
+ **/
+int axidma_acquire_channel(axidma_dev_t dev, int channel);
+
+/**
+ * Releases the DMA engine backing the given channel.
+ *
+ * Gives the channel's engine back to the kernel's DMA subsystem once this
+ * process is done with it, making it available to other kernel consumers.
+ * Any transfers still in flight on the channel are terminated, as with
+ * #axidma_stop_transfer. The channel remains valid, and is re-acquired
+ * automatically if it is used again.
+ *
+ * Releasing a channel that was never acquired is a no-op. This function will
+ * abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to release.
+ * @return 0 upon success, a negative number on failure (e.g. if another
+ *         process has claimed the channel).
+ **/
+int axidma_release_channel(axidma_dev_t dev, int channel);
+
+/**
+ * Registers an eventfd to be signaled upon completion of asynchronous
+ * transfers on the specified DMA channel.
+ *
+ * This is an alternative to the signal-based callback mechanism of
+ * #axidma_set_callback. When an eventfd is registered for a channel, the
+ * driver signals it on each completed asynchronous transfer instead of
+ * delivering a real-time signal, so completions can be waited on with
+ * select/poll/epoll alongside other file descriptors. This avoids the
+ * serialization cost of signal delivery in multi-threaded programs.
+ *
+ * Note that any callback registered with #axidma_set_callback will no longer
+ * be invoked for the channel while an eventfd is registered. Passing a
+ * negative \p eventfd_fd unregisters the eventfd, reverting the channel to
+ * signal-based notification.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to register the eventfd for.
+ * @param[in] eventfd_fd An eventfd file descriptor created by eventfd(2), or
+ *                       a negative value to unregister.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_set_eventfd(axidma_dev_t dev, int channel, int eventfd_fd);
+
 /**
  * Registers a user callback function to be invoked upon completion of an
  * asynchronous transfer for the specified DMA channel.
@@ -189,6 +557,113 @@ void axidma_unregister_buffer(axidma_dev_t dev, void *user_addr);
 void axidma_set_callback(axidma_dev_t dev, int channel, axidma_cb_t callback,
                          void *data);
 
+/**
+ * Starts the callback dispatch thread for the device.
+ *
+ * By default, callbacks registered with #axidma_set_callback run directly
+ * inside the completion signal handler, so they are restricted to
+ * async-signal-safe code and block the delivery of every other channel's
+ * completion signal while they run. While the dispatcher is running, the
+ * handler instead pushes completions into a lock-free queue drained by a
+ * dedicated library thread, which invokes the callbacks in ordinary thread
+ * context. Callbacks are then free to block, lock, and allocate, and a slow
+ * callback delays only the callbacks queued behind it, not signal delivery.
+ *
+ * Callbacks for all channels are invoked on the one dispatch thread, in
+ * completion order. Starting a dispatcher that is already running is a
+ * no-op.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_start_dispatcher(axidma_dev_t dev);
+
+/**
+ * Stops the callback dispatch thread for the device.
+ *
+ * This waits for the thread to finish the callback it is running, if any,
+ * and to drain the already queued completions, then joins it. Callbacks
+ * revert to being invoked inside the completion signal handler. Stopping a
+ * dispatcher that is not running is a no-op. This is also done automatically
+ * by #axidma_destroy.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ **/
+void axidma_stop_dispatcher(axidma_dev_t dev);
+
+/**
+ * Opens a handle to the DMA channel with the given id.
+ *
+ * This function resolves the channel's direction, type, and transfer command
+ * once, and returns a handle caching them. Transfers performed through the
+ * handle with #axidma_chan_oneway_transfer or #axidma_chan_submit_transfer
+ * skip the per-call channel lookup, which is worthwhile on hot paths making
+ * hundreds of thousands of transfers per second. Several handles may be open
+ * for the same channel, and a handle stays valid until it is closed with
+ * #axidma_close_channel or the device is destroyed.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to open a handle to.
+ * @return A channel handle upon success, NULL if the channel does not exist
+ *         or memory for the handle cannot be allocated.
+ **/
+axidma_chan_handle_t axidma_open_channel(axidma_dev_t dev, int channel);
+
+/**
+ * Closes a channel handle opened by #axidma_open_channel.
+ *
+ * This releases the handle's memory. The channel itself is unaffected, and
+ * any transfers in flight on it continue.
+ *
+ * @param[in] chan An #axidma_chan_handle_t returned by #axidma_open_channel.
+ **/
+void axidma_close_channel(axidma_chan_handle_t chan);
+
+/**
+ * Performs a single DMA transfer on a channel named by a handle.
+ *
+ * This function behaves identically to #axidma_oneway_transfer, except that
+ * the channel is named by a handle from #axidma_open_channel, so no per-call
+ * channel lookup is performed.
+ *
+ * The addresses \p buf and \p buf+\p len must be within a buffer that was
+ * previously allocated by #axidma_malloc or registered with
+ * #axidma_register_buffer.
+ *
+ * @param[in] chan An #axidma_chan_handle_t returned by #axidma_open_channel.
+ * @param[in] buf Address of the DMA buffer to transfer, previously allocated
+ *                by #axidma_malloc or registered with
+ *                #axidma_register_buffer.
+ * @param[in] len Number of bytes that will be transfered.
+ * @param[in] wait Indicates if the transfer should be synchronous or
+ *                 asynchronous. If true, this function will block.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_chan_oneway_transfer(axidma_chan_handle_t chan, void *buf,
+        size_t len, bool wait);
+
+/**
+ * Submits an asynchronous DMA transfer on a channel named by a handle.
+ *
+ * This function behaves identically to #axidma_submit_transfer, except that
+ * the channel is named by a handle from #axidma_open_channel, so no per-call
+ * channel lookup is performed.
+ *
+ * The addresses \p buf and \p buf+\p len must be within a buffer that was
+ * previously allocated by #axidma_malloc or registered with
+ * #axidma_register_buffer.
+ *
+ * @param[in] chan An #axidma_chan_handle_t returned by #axidma_open_channel.
+ * @param[in] buf Address of the DMA buffer to transfer, previously allocated
+ *                by #axidma_malloc or registered with
+ *                #axidma_register_buffer.
+ * @param[in] len Number of bytes that will be transfered.
+ * @return The positive transfer id upon success, a negative number on
+ *         failure.
+ **/
+int axidma_chan_submit_transfer(axidma_chan_handle_t chan, void *buf,
+        size_t len);
+
 /**
  * Performs a single DMA transfer in the specified direction on the DMA channel.
  *
@@ -213,6 +688,456 @@ void axidma_set_callback(axidma_dev_t dev, int channel, axidma_cb_t callback,
 int axidma_oneway_transfer(axidma_dev_t dev, int channel, void *buf, size_t len,
         bool wait);
 
+/**
+ * Performs a blocking DMA transfer bounded by the given timeout.
+ *
+ * This function behaves like #axidma_oneway_transfer with \p wait true,
+ * except that a transfer that does not complete within \p timeout_ms
+ * milliseconds fails with an ETIME error, instead of after the driver's
+ * default timeout of 10 seconds. This lets latency-sensitive callers bound a
+ * stalled transfer at their own deadline. A timeout of 0 uses the driver's
+ * default.
+ *
+ * The addresses \p buf and \p buf+\p len must be within a buffer that was
+ * previously allocated by #axidma_malloc or registered with
+ * #axidma_register_buffer. This function will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer is performed on.
+ * @param[in] buf Address of the DMA buffer to transfer, previously allocated
+ *                by #axidma_malloc or registered with
+ *                #axidma_register_buffer.
+ * @param[in] len Number of bytes that will be transfered.
+ * @param[in] timeout_ms Timeout for the transfer in milliseconds, or 0 to use
+ *                       the driver's default timeout.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_oneway_transfer_timeout(axidma_dev_t dev, int channel, void *buf,
+        size_t len, int timeout_ms);
+
+/**
+ * Submits an asynchronous DMA transfer, returning its assigned transfer id.
+ *
+ * This function behaves like #axidma_oneway_transfer with \p wait false,
+ * except that it returns the positive transfer id the driver assigned to the
+ * submission. Several transfers can be kept in flight on a channel at once,
+ * keeping the DMA engine's descriptor pipeline full, and the id matches the
+ * cookie reported in the shared completion ring (see
+ * #axidma_reap_completions) when the transfer finishes, so completions can be
+ * matched back to their submissions.
+ *
+ * The addresses \p buf and \p buf+\p len must be within a buffer that was
+ * previously allocated by #axidma_malloc or registered with
+ * #axidma_register_buffer. This function will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer is performed on.
+ * @param[in] buf Address of the DMA buffer to transfer, previously allocated
+ *                by #axidma_malloc or registered with
+ *                #axidma_register_buffer.
+ * @param[in] len Number of bytes that will be transfered.
+ * @return The positive transfer id upon success, a negative number on
+ *         failure.
+ **/
+int axidma_submit_transfer(axidma_dev_t dev, int channel, void *buf,
+        size_t len);
+
+/**
+ * Cancels a single in-flight DMA transfer on the given channel.
+ *
+ * This function abandons the transfer with the given id, previously returned
+ * by #axidma_submit_transfer, leaving the other transfers queued on the
+ * channel undisturbed, unlike #axidma_stop_transfer, which terminates
+ * everything in flight. The canceled transfer's completion is never reported
+ * through the completion ring, eventfd, or signal notification. The DMA
+ * engine cannot abort a single transfer in place, so it keeps working on the
+ * transfer until it completes; only the notification is suppressed. This
+ * function will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer was submitted on.
+ * @param[in] transfer_id Transfer id returned by #axidma_submit_transfer.
+ * @return 0 upon success, a negative number on failure. The errno is set to
+ *         ENOENT if the transfer is not in flight, which includes transfers
+ *         that have already completed.
+ **/
+int axidma_cancel_transfer(axidma_dev_t dev, int channel, int transfer_id);
+
+/**
+ * Returns a pre-resolved handle for the DMA buffer at the given address.
+ *
+ * This function asks the driver to resolve the DMA address of the buffer
+ * once, up front, and returns an opaque handle for it. Transfers performed
+ * with #axidma_oneway_transfer_h using the handle skip the kernel's address
+ * translation entirely, which is worthwhile for hot buffers that are reused
+ * across many transfers.
+ *
+ * The address \p addr must be within a buffer that was previously allocated
+ * by #axidma_malloc or registered with #axidma_register_buffer. Handles are
+ * a limited driver resource, and a handle is invalidated when its underlying
+ * buffer is freed or unregistered.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] addr Address of the DMA buffer to resolve, previously allocated
+ *                 by #axidma_malloc or registered with
+ *                 #axidma_register_buffer.
+ * @return A positive buffer handle upon success, a negative number on failure.
+ **/
+int axidma_get_buffer_handle(axidma_dev_t dev, void *addr);
+
+/**
+ * Performs a single DMA transfer using a pre-resolved buffer handle.
+ *
+ * This function behaves identically to #axidma_oneway_transfer, except that
+ * the buffer is named by a handle from #axidma_get_buffer_handle and a byte
+ * offset into the handle's buffer, instead of a virtual address. The kernel
+ * performs no address translation for the transfer. This function will abort
+ * if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer is performed on.
+ * @param[in] handle Buffer handle returned by #axidma_get_buffer_handle.
+ * @param[in] offset Byte offset into the handle's buffer to transfer at.
+ * @param[in] len Number of bytes that will be transfered.
+ * @param[in] wait Indicates if the transfer should be synchronous or
+ *                 asynchronous. If true, this function will block.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_oneway_transfer_h(axidma_dev_t dev, int channel, int handle,
+        size_t offset, size_t len, bool wait);
+
+/**
+ * Creates a pre-prepared transfer template for the given buffer and channel.
+ *
+ * A loop that performs the same transfer repeatedly -- same channel, buffer,
+ * and length -- pays for the kernel's address translation and descriptor
+ * chain construction on every submission. A template does that work once,
+ * when it is created; #axidma_template_trigger then resubmits it with no
+ * per-iteration preparation cost. On DMA engines that support the kernel's
+ * descriptor reuse facility, even the engine's own descriptor is reused
+ * across triggers.
+ *
+ * The buffer must come from #axidma_malloc or a registered external buffer,
+ * and the channel must be a normal DMA (not VDMA) channel. Templates are a
+ * limited driver resource, and should be destroyed with
+ * #axidma_template_destroy when no longer needed. This function will abort
+ * if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the template is bound to.
+ * @param[in] buf Address of the buffer the template transfers.
+ * @param[in] len Number of bytes the template transfers.
+ * @return A positive template id upon success, a negative number on failure.
+ **/
+int axidma_template_create(axidma_dev_t dev, int channel, void *buf,
+        size_t len);
+
+/**
+ * Triggers a transfer from a pre-prepared template.
+ *
+ * This resubmits the template created with #axidma_template_create to its
+ * channel, skipping the preparation work of a normal submission. The
+ * transfer otherwise behaves as an #axidma_oneway_transfer: it can block or
+ * not, and its completion reaches the registered notification paths.
+ *
+ * On engines that reuse the descriptor, only one trigger of a template can
+ * be in flight at a time; triggering again before the previous transfer
+ * completes fails with the errno set to EBUSY.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] template_id Template id returned by #axidma_template_create.
+ * @param[in] wait Indicates if the transfer should be synchronous or
+ *                 asynchronous. If true, this function will block.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_template_trigger(axidma_dev_t dev, int template_id, bool wait);
+
+/**
+ * Destroys a pre-prepared transfer template.
+ *
+ * This frees the driver-side resources of the template. A template whose
+ * transfer is still in flight cannot be destroyed until it completes. Any
+ * templates remaining when #axidma_destroy is called are destroyed
+ * automatically.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] template_id Template id returned by #axidma_template_create.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_template_destroy(axidma_dev_t dev, int template_id);
+
+/**
+ * Performs a single DMA transfer completed by polling, not interrupts.
+ *
+ * This function behaves like #axidma_oneway_transfer with \p wait true,
+ * except that the driver busy-polls the engine's completion status from the
+ * submitting CPU instead of sleeping until the completion interrupt's
+ * callback runs. For small transfers, the sleep/wakeup round trip costs far
+ * more than the transfer itself, so polling cuts the round-trip latency
+ * several-fold. The spin is bounded: past a short budget the driver yields
+ * between status checks, so a slow transfer does not monopolize the CPU.
+ *
+ * Use this only on latency-critical channels with small transfers; for bulk
+ * transfers the burned CPU time outweighs the saved wakeup. Only normal DMA
+ * (not VDMA) channels support polling. The buffer rules match
+ * #axidma_oneway_transfer. This function will abort if the channel is
+ * invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer is performed on.
+ * @param[in] buf Address of the DMA buffer to transfer, previously allocated
+ *                by #axidma_malloc or registered with
+ *                #axidma_register_buffer.
+ * @param[in] len Number of bytes that will be transfered.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_oneway_transfer_poll(axidma_dev_t dev, int channel, void *buf,
+        size_t len);
+
+/**
+ * Performs a single DMA transfer directly from arbitrary process memory.
+ *
+ * This function behaves identically to #axidma_oneway_transfer, except that
+ * \p buf may be any readable and writable range of the process's memory, such
+ * as a heap allocation or a buffer handed over by another library, rather
+ * than one allocated by #axidma_malloc or registered with
+ * #axidma_register_buffer. The driver pins the buffer's pages in place for
+ * the duration of the transfer and performs the DMA against them directly,
+ * so the data moves with no staging copy through a dedicated DMA buffer.
+ *
+ * Pinning the pages costs more per transfer than the address translation of
+ * a pre-allocated DMA buffer, so this is intended for bulk transfers where
+ * eliminating the staging memcpy dominates that cost. This function will
+ * abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer is performed on.
+ * @param[in] buf Address of the buffer to transfer. May be any valid range
+ *                of the process's memory.
+ * @param[in] len Number of bytes that will be transfered.
+ * @param[in] wait Indicates if the transfer should be synchronous or
+ *                 asynchronous. If true, this function will block.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_oneway_transfer_user(axidma_dev_t dev, int channel, void *buf,
+        size_t len, bool wait);
+
+/**
+ * Configures interrupt coalescing for the given DMA channel.
+ *
+ * This function sets the number of completed transfers the engine
+ * accumulates before raising an interrupt, and the delay timer that flushes
+ * a partial batch so completions are never held back indefinitely. Raising
+ * the coalescing count on bulk channels divides the interrupt load by the
+ * same factor, which matters when many small transfers are kept in flight;
+ * latency-sensitive channels should stay at the default of one interrupt
+ * per completion.
+ *
+ * The settings take effect from the next transfer on the channel. For plain
+ * DMA channels, the engine-level configuration is only available on Xilinx
+ * vendor kernels that export it (build the driver with
+ * XILINX_DMA_HAS_DMA_CONFIG); elsewhere the settings apply to VDMA channels
+ * only. This function will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to configure.
+ * @param[in] coalesce Number of completions per interrupt, from 1 to 255.
+ * @param[in] delay Delay timer for flushing partial batches, from 0
+ *                  (disabled) to 255, in units of 125 clock periods.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_set_coalescing(axidma_dev_t dev, int channel, int coalesce,
+        int delay);
+
+/**
+ * Reads the accumulated statistics of the given DMA channel.
+ *
+ * The driver counts the transfers submitted and completed on each channel,
+ * along with the bytes moved, the transfers that failed or timed out, and
+ * the cumulative submit-to-completion latency in nanoseconds; dividing
+ * latency_ns by completed gives the mean per-transfer latency. Reading the
+ * counters does not perturb in-flight transfers, so this is suitable for
+ * periodic polling by a monitoring agent. The same counters are mirrored in
+ * debugfs at axidma/stats. This function will abort if the channel is
+ * invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to read the statistics of.
+ * @param[out] stats Receives the channel's counters.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_get_stats(axidma_dev_t dev, int channel,
+        struct axidma_chan_stats *stats);
+
+/**
+ * Reads the stage timestamps of the last transfer completed on the channel.
+ *
+ * The driver timestamps each transfer as it moves through its lifecycle:
+ * submission from user space, descriptor preparation, issue to the hardware,
+ * the hardware completion interrupt, and the delivery of the completion
+ * notification. The timestamps of the channel's most recently completed
+ * transfer are retained and returned here, in nanoseconds on the kernel's
+ * monotonic clock, so the gap a latency spike fell into can be identified.
+ * The issue timestamp is reported as zero for transfers submitted as part
+ * of a batch. The same stages also fire ftrace tracepoints under the
+ * axidma trace system, which record every transfer rather than only the
+ * last one. This function will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to read the timestamps of.
+ * @param[out] times Receives the last transfer's stage timestamps.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_get_transfer_times(axidma_dev_t dev, int channel,
+        struct axidma_transfer_times *times);
+
+/**
+ * Starts a cyclic streaming transfer on the given DMA channel.
+ *
+ * This function cuts the given buffer into \p num_periods equally sized ring
+ * slots, and starts a transfer that the DMA engine services continuously,
+ * wrapping from the last slot back to the first with no gap in between. This
+ * is the right primitive for gap-free continuous capture (or playback) on a
+ * normal DMA channel: the engine never idles waiting for a re-submission, so
+ * no samples are dropped between blocks. Filled slots are consumed with
+ * #axidma_stream_next, and the stream runs until #axidma_stream_stop.
+ *
+ * The buffer must have been allocated by #axidma_malloc, its length must be
+ * a multiple of \p num_periods, and the channel must be a normal DMA (not
+ * VDMA) channel. Only one stream may be active per channel, and while one
+ * is, no one-shot transfers may be submitted on the channel. This function
+ * will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel to stream on.
+ * @param[in] buf Address of the ring buffer backing the stream, previously
+ *                allocated by #axidma_malloc.
+ * @param[in] len Total length of the ring buffer in bytes.
+ * @param[in] num_periods Number of slots to cut the ring buffer into. Must
+ *                        be at least 2, and must divide \p len evenly.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_stream_start(axidma_dev_t dev, int channel, void *buf, size_t len,
+        int num_periods);
+
+/**
+ * Consumes the next filled slot of a cyclic streaming transfer.
+ *
+ * This function returns a pointer to the oldest ring slot that the DMA
+ * engine has filled and that has not yet been consumed. The slot's data is
+ * \p len / \p num_periods bytes long (as given to #axidma_stream_start), and
+ * remains valid until the engine wraps back around to the slot, so it should
+ * be consumed promptly. If the consumer falls more than a full ring behind
+ * the engine, the overwritten slots are skipped and counted through
+ * \p dropped, and consumption resumes with the oldest intact slot.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the stream is running on.
+ * @param[in] wait Indicates if the call should block until a slot is ready.
+ *                 If false and no slot is ready, NULL is returned.
+ * @param[out] dropped If non-NULL, receives the number of slots that were
+ *                     overwritten before they could be consumed.
+ * @return A pointer to the filled slot's data upon success, NULL if no slot
+ *         is ready (non-blocking) or on failure.
+ **/
+void *axidma_stream_next(axidma_dev_t dev, int channel, bool wait,
+        unsigned long *dropped);
+
+/**
+ * Stops the cyclic streaming transfer on the given DMA channel.
+ *
+ * This function terminates the stream started with #axidma_stream_start and
+ * wakes up any threads blocked in #axidma_stream_next. The channel can then
+ * be used for one-shot transfers or a new stream.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the stream is running on.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_stream_stop(axidma_dev_t dev, int channel);
+
+/**
+ * Submits a batch of DMA transfers to the engine in a single system call.
+ *
+ * This function prepares and submits all of the given transactions, and then
+ * starts the DMA engine once per involved channel, amortizing both the system
+ * call and engine submission overhead across the batch. This is the preferred
+ * way to dispatch many small transfers. Read and write transactions can be
+ * freely mixed in one batch; the direction of each is determined by its
+ * channel. Only normal DMA channels may be used in a batch (no VDMA).
+ *
+ * The caller fills in the channel_id, buf, and buf_len fields of each
+ * transaction, and sets buf_handle to 0, or to a handle from
+ * #axidma_get_buffer_handle with buf carrying the byte offset. The
+ * per-transaction wait field is ignored in favor of the batch-level \p wait
+ * flag. The buffers follow the same rules as #axidma_oneway_transfer.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] trans An array of transactions to submit.
+ * @param[in] num_trans The number of transactions in \p trans.
+ * @param[in] wait Indicates if the call should block until every transaction
+ *                 in the batch has completed.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_batch_transfer(axidma_dev_t dev, struct axidma_transaction *trans,
+        int num_trans, bool wait);
+
+/**
+ * Performs a single bulk DMA transfer striped across several channels.
+ *
+ * This function splits the buffer into chunks of \p chunk_size bytes, submits
+ * the chunks round-robin across all of the listed channels so the engines run
+ * in parallel, and blocks until the last chunk has completed. On hardware with
+ * several independent channels of one direction, this scales the effective
+ * bandwidth of a bulk transfer nearly linearly with the number of channels.
+ * The channel arrays returned by #axidma_get_dma_tx and #axidma_get_dma_rx
+ * can be passed in directly to stripe across every channel of a direction.
+ *
+ * All of the listed channels must exist, and must share a single direction;
+ * this function will abort if they do not. The completions are aggregated
+ * through an eventfd that is registered on each of the listed channels for
+ * the duration of the call, replacing any eventfd previously registered on
+ * them with #axidma_set_eventfd. The buffer follows the same rules as
+ * #axidma_oneway_transfer.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channels The DMA channels to stripe the transfer across.
+ * @param[in] buf Address of the buffer to transfer, previously allocated by
+ *                #axidma_malloc or registered with #axidma_register_buffer.
+ * @param[in] len The number of bytes to transfer.
+ * @param[in] chunk_size The number of bytes submitted to a channel at a time.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_striped_transfer(axidma_dev_t dev, const array_t *channels,
+        void *buf, size_t len, size_t chunk_size);
+
+/**
+ * Performs a single vectored DMA transfer in the specified direction on the
+ * DMA channel.
+ *
+ * This function behaves identically to #axidma_oneway_transfer, except that
+ * the data is gathered from (transmit) or scattered into (receive) an
+ * arbitrary number of buffer segments instead of a single contiguous buffer.
+ * All of the segments are walked by the DMA engine in a single descriptor
+ * chain, so no staging copies are required for fragmented data.
+ *
+ * Each segment in \p iov must be within a buffer that was previously allocated
+ * by #axidma_malloc or registered with #axidma_register_buffer. This function
+ * will abort if the channel is invalid.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] channel DMA channel the transfer is performed on.
+ * @param[in] iov An array of buffer segments to transfer, each previously
+ *                allocated by #axidma_malloc or registered with
+ *                #axidma_register_buffer.
+ * @param[in] icount The number of segments in \p iov.
+ * @param[in] wait Indicates if the transfer should be synchronous or
+ *                 asynchronous. If true, this function will block.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_oneway_transfer_v(axidma_dev_t dev, int channel,
+        const struct axidma_iovec *iov, int icount, bool wait);
+
 /**
  * Performs a two coupled DMA transfers, one in the receive direction, the other
  * in the transmit direction.
@@ -277,6 +1202,31 @@ int axidma_twoway_transfer(axidma_dev_t dev, int tx_channel, void *tx_buf,
 int axidma_video_transfer(axidma_dev_t dev, int display_channel, size_t width,
         size_t height, size_t depth, void **frame_buffers, int num_buffers);
 
+/**
+ * Switches the frame buffer a running video transfer scans out.
+ *
+ * This function parks the VDMA engine on the frame buffer with the given
+ * index, chosen from the buffers passed to #axidma_video_transfer. The
+ * engine finishes the frame it is currently processing before switching, so
+ * the change is tear-free, and the transfer keeps running throughout --
+ * unlike stopping and restarting it, which blanks the display for several
+ * frames. This is the building block for double and triple buffering: render
+ * into an off-screen frame buffer, then park the display on it.
+ *
+ * A negative frame index resumes circulating through all of the transfer's
+ * frame buffers. This function will abort if the channel is invalid or not a
+ * VDMA channel, and fails if no video transfer is running on the channel.
+ *
+ * @param[in] dev An #axidma_dev_t returned by #axidma_init.
+ * @param[in] display_channel VDMA channel the video transfer is running on.
+ * @param[in] frame_index The index of the frame buffer to park on, or a
+ *                        negative value to resume circulating through all
+ *                        frames.
+ * @return 0 upon success, a negative number on failure.
+ **/
+int axidma_video_set_frame(axidma_dev_t dev, int display_channel,
+        int frame_index);
+
 /**
  * Stops the DMA transfer on specified DMA channel.
  *
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>             // Fixed-width integer types
 #include <assert.h>
 #include <string.h>             // Memset and memcpy functions
 #include <fcntl.h>              // Flags for open()
@@ -21,8 +22,10 @@
 #include <sys/mman.h>           // Mmap system call
 #include <sys/ioctl.h>          // IOCTL system call
 #include <unistd.h>             // Close() system call
+#include <sys/eventfd.h>        // Eventfd creation for pipeline completions
 #include <errno.h>              // Error codes
 #include <signal.h>             // Signal handling functions
+#include <pthread.h>            // The callback dispatch thread
 
 #include "libaxidma.h"          // Local definitions
 #include "axidma_ioctl.h"       // The IOCTL interface to AXI DMA
@@ -38,8 +41,38 @@ typedef struct dma_channel {
     int channel_id;             ///< Integer id of the channel.
     axidma_cb_t callback;       ///< Callback function for channel completion
     void *user_data;            ///< User data to pass to the callback
+    void *stream_buf;           ///< Ring buffer of the active stream (if any)
+    size_t stream_period_len;   ///< Length of one slot of the stream ring
 } dma_channel_t;
 
+/* The number of slots in the callback dispatch queue. This must be a power
+ * of two, so the indices can wrap with a mask. */
+#define DISPATCH_QUEUE_ENTRIES  256
+
+/* The callback dispatcher. When dispatching is enabled, the completion
+ * signal handler pushes the completed channel's id into a lock-free
+ * bounded queue and signals an eventfd, and a dedicated library thread
+ * drains the queue, invoking the user callbacks in ordinary thread context.
+ * Callbacks are then free to do real work -- block, lock, allocate --
+ * without being restricted to async-signal-safe code, and without stalling
+ * the delivery of every other channel's completion signal while they run.
+ *
+ * The driver signals the thread that submitted each transfer, so handlers
+ * for different channels can run concurrently on different threads. The
+ * producer side therefore claims slots with a per-slot sequence number and
+ * a compare-and-swap on the tail: a slot's sequence equals its position
+ * when it is free to claim, position + 1 once its record is published, and
+ * advances by the queue size each time the slot is recycled. */
+struct axidma_dispatcher {
+    bool running;               ///< The dispatcher thread is running
+    pthread_t thread;           ///< The callback dispatch thread
+    int efd;                    ///< Eventfd counting queued completions
+    uint32_t head;              ///< Consumer index, owned by the thread
+    uint32_t tail;              ///< Producer index, claimed by handlers
+    uint32_t seq[DISPATCH_QUEUE_ENTRIES];   ///< Per-slot sequence numbers
+    int queue[DISPATCH_QUEUE_ENTRIES];  ///< Channel ids awaiting dispatch
+};
+
 // The structure that represents the AXI DMA device
 struct axidma_dev {
     bool initialized;           ///< Indicates initialization for this struct.
@@ -50,6 +83,64 @@ struct axidma_dev {
     array_t vdma_rx_chans;      ///< Channel id's for the VDMA receive channels
     int num_channels;           ///< The total number of DMA channels
     dma_channel_t *channels;    ///< All of the VDMA/DMA channels in the system
+    struct axidma_cq_ring *cq_ring; ///< Shared completion ring, if mapped
+    struct axidma_dispatcher dispatch;  ///< The callback dispatcher, if started
+};
+
+/* A pool of fixed-size DMA buffers, sub-allocated from one large DMA region.
+ * The free list threads a 1-based block index through the first word of each
+ * free block, with 0 terminating the list. The list head packs that index
+ * together with a generation tag that is bumped on every pop, so a stale head
+ * value can never be mistaken for the current one after a block has been
+ * recycled (the classic ABA problem). */
+struct axidma_pool {
+    axidma_dev_t dev;           ///< The device the region was allocated from
+    void *base;                 ///< Base address of the underlying DMA region
+    size_t total_size;          ///< Size of the underlying DMA region
+    size_t block_size;          ///< Size of each block served by the pool
+    size_t num_blocks;          ///< The number of blocks in the pool
+    uint64_t free_head;         ///< Packed {generation tag, 1-based index}
+};
+
+// Packs and unpacks the pool free list head {generation tag, 1-based index}
+#define POOL_HEAD_PACK(tag, index)  (((uint64_t)(tag) << 32) | (index))
+#define POOL_HEAD_TAG(head)         ((uint32_t)((head) >> 32))
+#define POOL_HEAD_INDEX(head)       ((uint32_t)(head))
+
+/* A ping-pong pipeline of buffer pairs rotating through a transmit and a
+ * receive channel. The stages form a ring: while one stage's transfers are
+ * in flight, the next stage's transmit buffer is being filled by the CPU and
+ * the previous stage's receive buffer is being drained, keeping the engine
+ * busy continuously instead of idling between coupled transfers. */
+struct axidma_pipeline {
+    axidma_dev_t dev;           ///< The device the pipeline runs on
+    int tx_channel;             ///< Channel id of the transmit channel
+    int rx_channel;             ///< Channel id of the receive channel
+    size_t buf_size;            ///< Size of each buffer in a stage pair
+    int num_stages;             ///< The number of buffer pairs in the ring
+    void *region;               ///< DMA region backing all of the buffers
+    int efd;                    ///< Eventfd signaled on receive completions
+    int fill_index;             ///< Next stage to hand out for filling
+    int drain_index;            ///< Oldest stage still in flight
+    int in_flight;              ///< Stages submitted but not yet completed
+    uint64_t events;            ///< Completion events consumed but unclaimed
+};
+
+// The transmit and receive buffers of the given pipeline stage
+#define PIPELINE_TX_BUF(pipe, stage) \
+    ((char *)(pipe)->region + (size_t)(2 * (stage)) * (pipe)->buf_size)
+#define PIPELINE_RX_BUF(pipe, stage) \
+    ((char *)(pipe)->region + (size_t)(2 * (stage) + 1) * (pipe)->buf_size)
+
+/* A resolved handle for a single DMA channel. The channel's direction, type,
+ * and transfer ioctl command are resolved once when the handle is opened, so
+ * the transfer calls taking a handle do no per-call channel table scan. */
+struct axidma_chan_handle {
+    axidma_dev_t dev;           ///< The device the channel belongs to
+    int channel_id;             ///< The id of the channel
+    enum axidma_dir dir;        ///< Direction of the channel
+    enum axidma_type type;      ///< Type of the channel
+    unsigned long xfer_cmd;     ///< The resolved transfer ioctl command
 };
 
 // The DMA device structure, and a boolean checking if it's already open
@@ -137,6 +228,8 @@ static int categorize_channels(axidma_dev_t dev,
         dma_chan->channel_id = chan->channel_id;
         dma_chan->callback = NULL;
         dma_chan->user_data = NULL;
+        dma_chan->stream_buf = NULL;
+        dma_chan->stream_period_len = 0;
     }
 
     // Assign the length of the arrays
@@ -188,6 +281,11 @@ static int probe_channels(axidma_dev_t dev)
 static void axidma_callback(int signal, siginfo_t *siginfo, void *context)
 {
     int channel_id;
+    uint32_t tail, seq;
+    int32_t dif;
+    bool claimed;
+    uint64_t count;
+    ssize_t rc;
     dma_channel_t *chan;
 
     assert(0 <= siginfo->si_int && siginfo->si_int < axidma_dev.num_channels);
@@ -195,9 +293,59 @@ static void axidma_callback(int signal, siginfo_t *siginfo, void *context)
     // Silence the compiler
     (void)signal;
     (void)context;
+    channel_id = siginfo->si_int;
+
+    /* If the dispatcher is running, hand the completion to its thread
+     * instead of invoking the callback here, where it would be limited to
+     * async-signal-safe code and block further signal delivery. The driver
+     * signals the submitting thread, so handlers can run concurrently on
+     * different threads; each claims a slot by advancing the tail with a
+     * compare-and-swap once the slot's sequence number shows it is free,
+     * and publishes the record with a release store of the sequence. The
+     * eventfd write is async-signal-safe. If the queue is full, fall
+     * through and run the callback in the handler rather than losing the
+     * completion. */
+    if (axidma_dev.dispatch.running) {
+        claimed = false;
+        tail = __atomic_load_n(&axidma_dev.dispatch.tail, __ATOMIC_RELAXED);
+        for (;;)
+        {
+            seq = __atomic_load_n(
+                &axidma_dev.dispatch.seq[tail % DISPATCH_QUEUE_ENTRIES],
+                __ATOMIC_ACQUIRE);
+            dif = (int32_t)(seq - tail);
+            if (dif == 0) {
+                // The slot is free; claiming the tail claims the slot
+                if (__atomic_compare_exchange_n(&axidma_dev.dispatch.tail,
+                        &tail, tail + 1, true, __ATOMIC_RELAXED,
+                        __ATOMIC_RELAXED)) {
+                    claimed = true;
+                    break;
+                }
+            } else if (dif < 0) {
+                // The slot is still occupied, so the queue is full
+                break;
+            } else {
+                // Another handler claimed the slot; retry at the new tail
+                tail = __atomic_load_n(&axidma_dev.dispatch.tail,
+                                       __ATOMIC_RELAXED);
+            }
+        }
+
+        if (claimed) {
+            axidma_dev.dispatch.queue[tail % DISPATCH_QUEUE_ENTRIES] =
+                channel_id;
+            __atomic_store_n(
+                &axidma_dev.dispatch.seq[tail % DISPATCH_QUEUE_ENTRIES],
+                tail + 1, __ATOMIC_RELEASE);
+            count = 1;
+            rc = write(axidma_dev.dispatch.efd, &count, sizeof(count));
+            (void)rc;
+            return;
+        }
+    }
 
     // If the user defined a callback for a given channel, invoke it
-    channel_id = siginfo->si_int;
     chan = &axidma_dev.channels[channel_id];
     if (chan->callback != NULL) {
         chan->callback(channel_id, chan->user_data);
@@ -206,6 +354,61 @@ static void axidma_callback(int signal, siginfo_t *siginfo, void *context)
     return;
 }
 
+/* The main loop of the callback dispatch thread. The thread sleeps on the
+ * dispatcher's eventfd until the signal handler queues a completion, then
+ * drains the queue, invoking the user callback of each completed channel in
+ * ordinary thread context. */
+static void *axidma_dispatch_thread(void *arg)
+{
+    axidma_dev_t dev;
+    uint32_t head, seq;
+    uint64_t count;
+    ssize_t rc;
+    int channel_id;
+    dma_channel_t *chan;
+
+    dev = arg;
+    for (;;)
+    {
+        // Sleep until completions are queued, or a stop is requested
+        rc = read(dev->dispatch.efd, &count, sizeof(count));
+        (void)rc;
+
+        /* Drain the queue. The acquire load of the slot's sequence number
+         * pairs with the handler's release store, so the queued channel id
+         * is visible, and the release store recycling the sequence frees
+         * the slot for a later lap of the producers. */
+        for (;;)
+        {
+            head = dev->dispatch.head;
+            seq = __atomic_load_n(
+                &dev->dispatch.seq[head % DISPATCH_QUEUE_ENTRIES],
+                __ATOMIC_ACQUIRE);
+            if ((int32_t)(seq - (head + 1)) < 0) {
+                // The next slot is claimed but not yet published, or empty
+                break;
+            }
+            channel_id = dev->dispatch.queue[head % DISPATCH_QUEUE_ENTRIES];
+            __atomic_store_n(
+                &dev->dispatch.seq[head % DISPATCH_QUEUE_ENTRIES],
+                head + DISPATCH_QUEUE_ENTRIES, __ATOMIC_RELEASE);
+            dev->dispatch.head = head + 1;
+
+            chan = &dev->channels[channel_id];
+            if (chan->callback != NULL) {
+                chan->callback(channel_id, chan->user_data);
+            }
+        }
+
+        // The stop request wakes the thread with the queue already drained
+        if (!dev->dispatch.running) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
 /* Sets up a signal handler for the lowest real-time signal to be delivered
  * whenever any asynchronous DMA transaction compeletes. */
 // TODO: Should really check if real time signal is being used
@@ -277,7 +480,7 @@ struct axidma_dev *axidma_init()
     assert(!axidma_dev.initialized);
 
     // Open the AXI DMA device
-    axidma_dev.fd = open(AXIDMA_DEV_PATH, O_RDWR|O_EXCL);
+    axidma_dev.fd = open(AXIDMA_DEV_PATH, O_RDWR);
     if (axidma_dev.fd < 0) {
         perror("Error opening AXI DMA device");
         fprintf(stderr, "Expected the AXI DMA device at the path `%s`\n",
@@ -307,6 +510,18 @@ struct axidma_dev *axidma_init()
 // Tears down the given AXI DMA device structure
 void axidma_destroy(axidma_dev_t dev)
 {
+    // Stop the callback dispatch thread, if it was started
+    axidma_stop_dispatcher(dev);
+
+    // Unmap the completion ring, if it was mapped
+    if (dev->cq_ring != NULL) {
+        if (munmap(dev->cq_ring, sysconf(_SC_PAGESIZE)) < 0) {
+            perror("Failed to unmap the completion ring");
+            assert(false);
+        }
+        dev->cq_ring = NULL;
+    }
+
     // Free the arrays used for channel id's and channel metadata
     free(dev->vdma_rx_chans.data);
     free(dev->vdma_tx_chans.data);
@@ -365,6 +580,25 @@ void *axidma_malloc(axidma_dev_t dev, size_t size)
     return addr;
 }
 
+/* Allocates a cached region of memory suitable for use with the AXI DMA
+ * driver. Unlike axidma_malloc, the buffer is backed by ordinary cached
+ * pages, so CPU-side processing of the data runs at full speed, but the
+ * buffer must be synchronized with axidma_sync_for_cpu/axidma_sync_for_device
+ * around each transfer. Free the buffer with axidma_free as usual. */
+void *axidma_malloc_cached(axidma_dev_t dev, size_t size)
+{
+    void *addr;
+
+    // The magic offset requests a cached allocation from the driver
+    addr = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, dev->fd,
+                AXIDMA_CACHED_BUF_OFFSET);
+    if (addr == MAP_FAILED) {
+        return NULL;
+    }
+
+    return addr;
+}
+
 /* This frees a region of memory that was allocated with a call to
  * axidma_malloc. The size passed in here must match the one used for that
  * call, or this function will throw an exception. */
@@ -381,6 +615,314 @@ void axidma_free(axidma_dev_t dev, void *addr, size_t size)
     return;
 }
 
+/* Hands ownership of a cached DMA buffer range to the processor, invalidating
+ * the caches over the range. This must be called after a receive transfer
+ * into a buffer from axidma_malloc_cached completes, before reading the
+ * received data. A no-op for buffers from axidma_malloc. */
+int axidma_sync_for_cpu(axidma_dev_t dev, void *buf, size_t len)
+{
+    int rc;
+    struct axidma_sync sync;
+
+    // Setup the argument structure to the IOCTL
+    sync.buf = buf;
+    sync.len = len;
+
+    rc = ioctl(dev->fd, AXIDMA_SYNC_FOR_CPU, &sync);
+    if (rc < 0) {
+        perror("Failed to synchronize the AXI DMA buffer for the CPU");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* Hands ownership of a cached DMA buffer range back to the device, writing
+ * dirty cache lines over the range back to memory. This must be called after
+ * writing data into a buffer from axidma_malloc_cached, before submitting the
+ * transmit transfer that sends it. A no-op for buffers from axidma_malloc. */
+int axidma_sync_for_device(axidma_dev_t dev, void *buf, size_t len)
+{
+    int rc;
+    struct axidma_sync sync;
+
+    // Setup the argument structure to the IOCTL
+    sync.buf = buf;
+    sync.len = len;
+
+    rc = ioctl(dev->fd, AXIDMA_SYNC_FOR_DEVICE, &sync);
+    if (rc < 0) {
+        perror("Failed to synchronize the AXI DMA buffer for the device");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* Creates a pool of fixed-size DMA buffers, backed by one large region from
+ * axidma_malloc. The expensive allocation happens once here, and the blocks
+ * are then served from a lock-free free list with no system calls. */
+axidma_pool_t axidma_pool_create(axidma_dev_t dev, size_t total_size,
+        size_t block_size)
+{
+    size_t i;
+    uint32_t *block;
+    axidma_pool_t pool;
+
+    /* Round the block size up to a multiple of the free list word, so that
+     * the blocks are aligned and can hold the free list link. */
+    block_size = (block_size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+    if (block_size == 0 || total_size < block_size) {
+        fprintf(stderr, "DMA pool must hold at least one block.\n");
+        return NULL;
+    }
+
+    // Allocate the pool structure
+    pool = malloc(sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    // Allocate the single large DMA region that backs all of the blocks
+    pool->dev = dev;
+    pool->total_size = total_size;
+    pool->block_size = block_size;
+    pool->num_blocks = total_size / block_size;
+    pool->base = axidma_malloc(dev, total_size);
+    if (pool->base == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    /* Thread the free list through the blocks, each block holding the 1-based
+     * index of the next one, with 0 terminating the list. */
+    for (i = 0; i < pool->num_blocks; i++)
+    {
+        block = (uint32_t *)((char *)pool->base + i * block_size);
+        *block = (i + 1 < pool->num_blocks) ? (uint32_t)(i + 2) : 0;
+    }
+    pool->free_head = POOL_HEAD_PACK(0, 1);
+
+    return pool;
+}
+
+/* Destroys a DMA buffer pool, freeing its underlying DMA region. This
+ * invalidates all of the buffers served by the pool. */
+void axidma_pool_destroy(axidma_pool_t pool)
+{
+    axidma_free(pool->dev, pool->base, pool->total_size);
+    free(pool);
+    return;
+}
+
+/* Allocates a fixed-size DMA buffer from the given pool, by popping the head
+ * of the pool's free list. This involves no system calls, and is safe against
+ * concurrent allocations and frees from other threads. */
+void *axidma_pool_alloc(axidma_pool_t pool)
+{
+    uint64_t head, next_head;
+    uint32_t index, next_index;
+    void *block;
+
+    head = __atomic_load_n(&pool->free_head, __ATOMIC_ACQUIRE);
+    do {
+        // An index of 0 indicates that the free list is empty
+        index = POOL_HEAD_INDEX(head);
+        if (index == 0) {
+            return NULL;
+        }
+
+        /* Read the next link out of the head block, and bump the generation
+         * tag so a concurrent recycle of the block cannot go unnoticed. */
+        block = (char *)pool->base + (size_t)(index - 1) * pool->block_size;
+        next_index = *(volatile uint32_t *)block;
+        next_head = POOL_HEAD_PACK(POOL_HEAD_TAG(head) + 1, next_index);
+    } while (!__atomic_compare_exchange_n(&pool->free_head, &head, next_head,
+             false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    return block;
+}
+
+/* Returns a DMA buffer previously allocated from the pool, by pushing it back
+ * onto the head of the pool's free list. This involves no system calls, and
+ * is safe against concurrent allocations and frees from other threads. */
+void axidma_pool_free(axidma_pool_t pool, void *addr)
+{
+    uint64_t head, next_head;
+    size_t offset;
+    uint32_t index;
+
+    // The address must lie on a block boundary within the pool's region
+    offset = (char *)addr - (char *)pool->base;
+    assert(addr >= pool->base && offset < pool->total_size);
+    assert(offset % pool->block_size == 0);
+    index = (uint32_t)(offset / pool->block_size) + 1;
+
+    head = __atomic_load_n(&pool->free_head, __ATOMIC_RELAXED);
+    do {
+        // Link the freed block to the current head, then publish it
+        *(volatile uint32_t *)addr = POOL_HEAD_INDEX(head);
+        next_head = POOL_HEAD_PACK(POOL_HEAD_TAG(head), index);
+    } while (!__atomic_compare_exchange_n(&pool->free_head, &head, next_head,
+             false, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    return;
+}
+
+/* Creates a ping-pong pipeline of num_stages buffer pairs rotating through
+ * the given transmit and receive channels. The pipeline registers an eventfd
+ * on the receive channel to track completions, replacing any eventfd the
+ * caller registered there. */
+axidma_pipeline_t axidma_pipeline_create(axidma_dev_t dev, int tx_channel,
+        int rx_channel, size_t buf_size, int num_stages)
+{
+    axidma_pipeline_t pipe;
+
+    assert(find_channel(dev, tx_channel) != NULL);
+    assert(find_channel(dev, tx_channel)->dir == AXIDMA_WRITE);
+    assert(find_channel(dev, rx_channel) != NULL);
+    assert(find_channel(dev, rx_channel)->dir == AXIDMA_READ);
+    assert(num_stages >= 2);
+
+    // Allocate the pipeline structure
+    pipe = malloc(sizeof(*pipe));
+    if (pipe == NULL) {
+        return NULL;
+    }
+    pipe->dev = dev;
+    pipe->tx_channel = tx_channel;
+    pipe->rx_channel = rx_channel;
+    pipe->buf_size = buf_size;
+    pipe->num_stages = num_stages;
+    pipe->fill_index = 0;
+    pipe->drain_index = 0;
+    pipe->in_flight = 0;
+    pipe->events = 0;
+
+    // Allocate one DMA region backing all of the stage buffer pairs
+    pipe->region = axidma_malloc(dev, 2 * num_stages * buf_size);
+    if (pipe->region == NULL) {
+        free(pipe);
+        return NULL;
+    }
+
+    /* Track receive completions with an eventfd on the receive channel. A
+     * stage is done once its receive transfer completes, and completions on
+     * one channel are reported in submission order. */
+    pipe->efd = eventfd(0, 0);
+    if (pipe->efd < 0) {
+        perror("Failed to create the pipeline completion eventfd");
+        axidma_free(dev, pipe->region, 2 * num_stages * buf_size);
+        free(pipe);
+        return NULL;
+    }
+    if (axidma_set_eventfd(dev, rx_channel, pipe->efd) < 0) {
+        close(pipe->efd);
+        axidma_free(dev, pipe->region, 2 * num_stages * buf_size);
+        free(pipe);
+        return NULL;
+    }
+
+    return pipe;
+}
+
+/* Destroys a ping-pong pipeline, freeing its buffers and unregistering its
+ * completion eventfd. Any transfers still in flight are abandoned. */
+void axidma_pipeline_destroy(axidma_pipeline_t pipe)
+{
+    axidma_set_eventfd(pipe->dev, pipe->rx_channel, -1);
+    close(pipe->efd);
+    axidma_free(pipe->dev, pipe->region,
+                2 * pipe->num_stages * pipe->buf_size);
+    free(pipe);
+    return;
+}
+
+/* Returns the transmit buffer of the next free pipeline stage, for the CPU
+ * to fill while earlier stages are in flight. Returns NULL when every stage
+ * is in flight; completing a stage frees it for filling again. */
+void *axidma_pipeline_tx_buf(axidma_pipeline_t pipe)
+{
+    if (pipe->in_flight == pipe->num_stages) {
+        return NULL;
+    }
+
+    return PIPELINE_TX_BUF(pipe, pipe->fill_index);
+}
+
+/* Submits the stage whose transmit buffer was last handed out, kicking off
+ * its transmit and receive transfers asynchronously. The receive transfer is
+ * submitted first, so the result has somewhere to land before the transmit
+ * pushes data into the accelerator. */
+int axidma_pipeline_submit(axidma_pipeline_t pipe, size_t tx_len,
+        size_t rx_len)
+{
+    int rc, rx_id;
+
+    assert(pipe->in_flight < pipe->num_stages);
+    assert(tx_len <= pipe->buf_size && rx_len <= pipe->buf_size);
+
+    rx_id = axidma_submit_transfer(pipe->dev, pipe->rx_channel,
+            PIPELINE_RX_BUF(pipe, pipe->fill_index), rx_len);
+    if (rx_id < 0) {
+        return rx_id;
+    }
+    rc = axidma_submit_transfer(pipe->dev, pipe->tx_channel,
+            PIPELINE_TX_BUF(pipe, pipe->fill_index), tx_len);
+    if (rc < 0) {
+        /* The receive transfer is already in flight, so back it out, or the
+         * completion counts would run one ahead of the stage counts for the
+         * rest of the pipeline's life. A canceled transfer never reports a
+         * completion, so the accounting is square again. */
+        if (axidma_cancel_transfer(pipe->dev, pipe->rx_channel, rx_id) == 0) {
+            return rc;
+        }
+
+        /* The receive transfer completed before it could be canceled, and
+         * its completion event is already pending on the eventfd. Count the
+         * stage as in flight so the event drains against it; the caller
+         * still sees the failure, and the stage's receive buffer holds
+         * whatever the accelerator produced without the transmit. */
+        pipe->fill_index = (pipe->fill_index + 1) % pipe->num_stages;
+        pipe->in_flight += 1;
+        return rc;
+    }
+
+    pipe->fill_index = (pipe->fill_index + 1) % pipe->num_stages;
+    pipe->in_flight += 1;
+    return 0;
+}
+
+/* Waits for the oldest in-flight pipeline stage to complete, and returns its
+ * receive buffer for the CPU to drain. The buffer remains valid until the
+ * stage is reused, which cannot happen before num_stages - 1 further submits.
+ * Returns NULL if no stage is in flight, or if the wait fails. */
+void *axidma_pipeline_complete(axidma_pipeline_t pipe)
+{
+    uint64_t count;
+    void *rx_buf;
+
+    if (pipe->in_flight == 0) {
+        return NULL;
+    }
+
+    /* Consume one receive completion. A single eventfd read can report
+     * several completions, so the surplus is banked for later calls. */
+    while (pipe->events == 0) {
+        if (read(pipe->efd, &count, sizeof(count)) != sizeof(count)) {
+            perror("Failed to read the pipeline completion eventfd");
+            return NULL;
+        }
+        pipe->events += count;
+    }
+    pipe->events -= 1;
+
+    rx_buf = PIPELINE_RX_BUF(pipe, pipe->drain_index);
+    pipe->drain_index = (pipe->drain_index + 1) % pipe->num_stages;
+    pipe->in_flight -= 1;
+    return rx_buf;
+}
+
 /* Sets up a callback function to be called whenever the transaction completes
  * on the given channel for asynchronous transfers. */
 void axidma_set_callback(axidma_dev_t dev, int channel, axidma_cb_t callback,
@@ -397,6 +939,224 @@ void axidma_set_callback(axidma_dev_t dev, int channel, axidma_cb_t callback,
     return;
 }
 
+/* Starts the callback dispatch thread. While it runs, callbacks registered
+ * with axidma_set_callback are invoked on the thread, in ordinary thread
+ * context, instead of inside the completion signal handler. Starting the
+ * dispatcher when it is already running is a no-op. */
+int axidma_start_dispatcher(axidma_dev_t dev)
+{
+    int rc, i;
+
+    // The dispatcher only needs to be started once
+    if (dev->dispatch.running) {
+        return 0;
+    }
+
+    // Create the eventfd the signal handler wakes the thread through
+    dev->dispatch.efd = eventfd(0, 0);
+    if (dev->dispatch.efd < 0) {
+        perror("Failed to create the dispatcher eventfd");
+        return -errno;
+    }
+    dev->dispatch.head = 0;
+    dev->dispatch.tail = 0;
+    for (i = 0; i < DISPATCH_QUEUE_ENTRIES; i++)
+    {
+        dev->dispatch.seq[i] = i;
+    }
+
+    /* Mark the dispatcher as running before creating the thread, so that no
+     * completion signal can slip past the handler's check unqueued. */
+    dev->dispatch.running = true;
+    rc = pthread_create(&dev->dispatch.thread, NULL, axidma_dispatch_thread,
+                        dev);
+    if (rc != 0) {
+        fprintf(stderr, "Failed to create the dispatcher thread: %s\n",
+                strerror(rc));
+        dev->dispatch.running = false;
+        close(dev->dispatch.efd);
+        return -rc;
+    }
+
+    return 0;
+}
+
+/* Stops the callback dispatch thread, waiting for it to finish any callback
+ * it is running and drain the queued completions. Callbacks revert to being
+ * invoked inside the completion signal handler. Stopping a dispatcher that
+ * is not running is a no-op. */
+void axidma_stop_dispatcher(axidma_dev_t dev)
+{
+    uint64_t count;
+    ssize_t rc;
+
+    if (!dev->dispatch.running) {
+        return;
+    }
+
+    /* Revert the handler to in-place invocation, then wake the thread so it
+     * drains the queue and observes the stop request. */
+    dev->dispatch.running = false;
+    count = 1;
+    rc = write(dev->dispatch.efd, &count, sizeof(count));
+    (void)rc;
+    pthread_join(dev->dispatch.thread, NULL);
+    close(dev->dispatch.efd);
+
+    return;
+}
+
+/* Maps the driver's shared completion ring into the process, enabling
+ * zero-syscall reaping of completions via axidma_reap_completions. */
+int axidma_setup_completion_ring(axidma_dev_t dev)
+{
+    void *addr;
+
+    // The ring only needs to be mapped once
+    if (dev->cq_ring != NULL) {
+        return 0;
+    }
+
+    // Map the single ring page at the magic completion ring offset
+    addr = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ|PROT_WRITE, MAP_SHARED,
+                dev->fd, AXIDMA_CQ_RING_OFFSET);
+    if (addr == MAP_FAILED) {
+        perror("Failed to map the completion ring");
+        return -errno;
+    }
+
+    dev->cq_ring = addr;
+    return 0;
+}
+
+/* Checks if a completion record is pending in the shared completion ring,
+ * without consuming it. Returns 1 if one is pending, and 0 otherwise. */
+int axidma_peek_completion(axidma_dev_t dev)
+{
+    struct axidma_cq_ring *ring;
+    unsigned int head, tail;
+
+    ring = dev->cq_ring;
+    assert(ring != NULL);
+
+    /* Pair the driver's release store to the tail index with an acquire
+     * load, so the records it published are visible to us. */
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    return (tail != head) ? 1 : 0;
+}
+
+/* Reaps up to max_entries completion records from the shared completion ring,
+ * copying them into the given array. This involves no system calls. Returns
+ * the number of records reaped, which may be zero. */
+int axidma_reap_completions(axidma_dev_t dev, struct axidma_cq_entry *entries,
+        int max_entries)
+{
+    struct axidma_cq_ring *ring;
+    unsigned int head, tail;
+    int num_reaped;
+
+    ring = dev->cq_ring;
+    assert(ring != NULL);
+
+    // Acquire the records published by the driver since our last reap
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    // Copy out the pending records, up to the length of the user's array
+    num_reaped = 0;
+    while (head != tail && num_reaped < max_entries)
+    {
+        entries[num_reaped] = ring->entries[head % ring->num_entries];
+        head += 1;
+        num_reaped += 1;
+    }
+
+    // Release the consumed ring slots back to the driver
+    __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+    return num_reaped;
+}
+
+/* Claims the given channel for this process's exclusive use. Once claimed,
+ * transfers on the channel from any other process fail until this process
+ * closes the device. This is how independent processes can each drive their
+ * own channels directly, without coordinating through a broker. */
+int axidma_claim_channel(axidma_dev_t dev, int channel)
+{
+    int rc;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Perform the channel claim with the driver
+    rc = ioctl(dev->fd, AXIDMA_CLAIM_CHANNEL, channel);
+    if (rc < 0) {
+        perror("Failed to claim the DMA channel");
+    }
+
+    return rc;
+}
+
+/* Acquires the DMA engine backing the given channel ahead of its first use.
+ * The driver acquires engines lazily, so this only moves the one-time cost
+ * to setup, and surfaces a busy engine before the data path depends on it. */
+int axidma_acquire_channel(axidma_dev_t dev, int channel)
+{
+    int rc;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Perform the channel acquisition with the driver
+    rc = ioctl(dev->fd, AXIDMA_ACQUIRE_CHANNEL, channel);
+    if (rc < 0) {
+        perror("Failed to acquire the DMA channel");
+    }
+
+    return rc;
+}
+
+/* Releases the DMA engine backing the given channel, making it available to
+ * other kernel consumers. Any transfers still in flight on the channel are
+ * terminated. The channel is re-acquired automatically if it is used
+ * again. */
+int axidma_release_channel(axidma_dev_t dev, int channel)
+{
+    int rc;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Perform the channel release with the driver
+    rc = ioctl(dev->fd, AXIDMA_RELEASE_CHANNEL, channel);
+    if (rc < 0) {
+        perror("Failed to release the DMA channel");
+    }
+
+    return rc;
+}
+
+/* Registers an eventfd to be signaled by the driver whenever an asynchronous
+ * transaction completes on the given channel. This replaces the signal-based
+ * notification (and thus any callback registered with axidma_set_callback)
+ * for that channel. Passing a negative fd reverts to signal delivery. */
+int axidma_set_eventfd(axidma_dev_t dev, int channel, int eventfd_fd)
+{
+    int rc;
+    struct axidma_eventfd efd;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Setup the argument structure to the IOCTL
+    efd.channel_id = channel;
+    efd.fd = eventfd_fd;
+
+    // Perform the eventfd registration with the driver
+    rc = ioctl(dev->fd, AXIDMA_SET_DMA_EVENTFD, &efd);
+    if (rc < 0) {
+        perror("Failed to register the completion eventfd");
+    }
+
+    return rc;
+}
+
 /* Registers a DMA buffer allocated by another driver with the AXI DMA driver.
  * This allows it to be used in DMA transfers later on. The user must make sure
  * that the driver that allocated the buffer has exported it. The file
@@ -437,24 +1197,274 @@ void axidma_unregister_buffer(axidma_dev_t dev, void *user_addr)
     return;
 }
 
-/* This performs a one-way transfer over AXI DMA, the direction being specified
- * by the user. The user determines if this is blocking or not with `wait. */
-int axidma_oneway_transfer(axidma_dev_t dev, int channel, void *buf,
-        size_t len, bool wait)
+/* Opens a handle to the DMA channel with the given id. The channel's
+ * direction, type, and transfer ioctl command are resolved once here, so the
+ * transfer calls taking the handle skip the channel lookup entirely. Returns
+ * NULL if the channel does not exist or memory cannot be allocated. */
+axidma_chan_handle_t axidma_open_channel(axidma_dev_t dev, int channel)
 {
-    int rc;
-    struct axidma_transaction trans;
-    unsigned long axidma_cmd;
     dma_channel_t *dma_chan;
+    axidma_chan_handle_t handle;
 
-    assert(find_channel(dev, channel) != NULL);
-
-    // Setup the argument structure to the IOCTL
+    // Resolve the channel once, up front
     dma_chan = find_channel(dev, channel);
-    trans.wait = wait;
-    trans.channel_id = channel;
-    trans.buf = buf;
-    trans.buf_len = len;
+    if (dma_chan == NULL) {
+        return NULL;
+    }
+
+    // Allocate the handle, and cache the channel's resolved information
+    handle = malloc(sizeof(*handle));
+    if (handle == NULL) {
+        return NULL;
+    }
+    handle->dev = dev;
+    handle->channel_id = channel;
+    handle->dir = dma_chan->dir;
+    handle->type = dma_chan->type;
+    handle->xfer_cmd = dir_to_ioctl(dma_chan->dir);
+
+    return handle;
+}
+
+/* Closes a channel handle, releasing its memory. The channel itself is
+ * unaffected; any transfers in flight on it continue. */
+void axidma_close_channel(axidma_chan_handle_t chan)
+{
+    free(chan);
+    return;
+}
+
+/* This performs a one-way transfer on a channel named by a handle from
+ * axidma_open_channel. This behaves like axidma_oneway_transfer, but does no
+ * per-call channel lookup, which is measurable at high transfer rates. */
+int axidma_chan_oneway_transfer(axidma_chan_handle_t chan, void *buf,
+        size_t len, bool wait)
+{
+    int rc;
+    struct axidma_transaction trans;
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = wait;
+    trans.poll = false;
+    trans.channel_id = chan->channel_id;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = 0;
+
+    // Perform the given transfer
+    rc = ioctl(chan->dev->fd, chan->xfer_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to perform the AXI DMA transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This submits an asynchronous one-way transfer on a channel named by a
+ * handle, returning the positive transfer id assigned by the driver. This
+ * behaves like axidma_submit_transfer, but does no per-call channel lookup. */
+int axidma_chan_submit_transfer(axidma_chan_handle_t chan, void *buf,
+        size_t len)
+{
+    int rc;
+    struct axidma_transaction trans;
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = false;
+    trans.poll = false;
+    trans.channel_id = chan->channel_id;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = 0;
+
+    // Submit the transfer to the driver
+    rc = ioctl(chan->dev->fd, chan->xfer_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to submit the AXI DMA transfer");
+        return rc;
+    }
+
+    return trans.transfer_id;
+}
+
+/* This performs a one-way transfer over AXI DMA, the direction being specified
+ * by the user. The user determines if this is blocking or not with `wait. */
+int axidma_oneway_transfer(axidma_dev_t dev, int channel, void *buf,
+        size_t len, bool wait)
+{
+    int rc;
+    struct axidma_transaction trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = wait;
+    trans.poll = false;
+    trans.channel_id = channel;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = 0;
+    axidma_cmd = dir_to_ioctl(dma_chan->dir);
+
+    // Perform the given transfer
+    rc = ioctl(dev->fd, axidma_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to perform the AXI DMA transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This performs a blocking one-way transfer over AXI DMA that fails with an
+ * ETIME error if it does not complete within the given number of
+ * milliseconds, instead of the driver's default timeout of 10 seconds. This
+ * lets latency-sensitive callers bound a stalled transfer at their own
+ * deadline. A timeout of 0 uses the driver's default. */
+int axidma_oneway_transfer_timeout(axidma_dev_t dev, int channel, void *buf,
+        size_t len, int timeout_ms)
+{
+    int rc;
+    struct axidma_transaction trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = true;
+    trans.poll = false;
+    trans.channel_id = channel;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = timeout_ms;
+    axidma_cmd = dir_to_ioctl(dma_chan->dir);
+
+    // Perform the given transfer
+    rc = ioctl(dev->fd, axidma_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to perform the AXI DMA transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This submits an asynchronous one-way transfer over AXI DMA, returning the
+ * positive transfer id assigned by the driver. Several transfers can be kept
+ * in flight on a channel at once, and the id matches the cookie reported in
+ * the completion ring when the transfer finishes. */
+int axidma_submit_transfer(axidma_dev_t dev, int channel, void *buf,
+        size_t len)
+{
+    int rc;
+    struct axidma_transaction trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = false;
+    trans.poll = false;
+    trans.channel_id = channel;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = 0;
+    axidma_cmd = dir_to_ioctl(dma_chan->dir);
+
+    // Submit the transfer to the driver
+    rc = ioctl(dev->fd, axidma_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to submit the AXI DMA transfer");
+        return rc;
+    }
+
+    return trans.transfer_id;
+}
+
+/* This cancels a single in-flight transfer submitted on the given channel,
+ * leaving the other transfers queued on the channel undisturbed. The
+ * canceled transfer's completion is never reported through the completion
+ * ring, eventfd, or signal. Returns a negative value with errno set to
+ * ENOENT if the transfer is not in flight, which includes transfers that
+ * have already completed. */
+int axidma_cancel_transfer(axidma_dev_t dev, int channel, int transfer_id)
+{
+    int rc;
+    struct axidma_cancel cancel;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Setup the argument structure to the IOCTL
+    cancel.channel_id = channel;
+    cancel.transfer_id = transfer_id;
+
+    // Perform the cancellation with the driver
+    rc = ioctl(dev->fd, AXIDMA_CANCEL_TRANSFER, &cancel);
+    if (rc < 0 && errno != ENOENT) {
+        perror("Failed to cancel the AXI DMA transfer");
+    }
+
+    return rc;
+}
+
+/* This returns a pre-resolved handle for the DMA buffer at the given address,
+ * which must come from axidma_malloc or a registered external buffer. The
+ * handle can be passed to axidma_oneway_transfer_h to skip the kernel's
+ * address translation on every transfer. Returns a negative value on error. */
+int axidma_get_buffer_handle(axidma_dev_t dev, void *addr)
+{
+    int rc;
+    struct axidma_buffer_handle buf_handle;
+
+    // Setup the argument structure to the IOCTL
+    buf_handle.user_addr = addr;
+
+    // Perform the handle resolution with the driver
+    rc = ioctl(dev->fd, AXIDMA_GET_BUFFER_HANDLE, &buf_handle);
+    if (rc < 0) {
+        perror("Failed to get a handle for the DMA buffer");
+        return rc;
+    }
+
+    return buf_handle.handle;
+}
+
+/* This performs a one-way transfer over AXI DMA using a pre-resolved buffer
+ * handle from axidma_get_buffer_handle, starting at the given byte offset
+ * into the handle's buffer. The user determines if this is blocking or not
+ * with `wait`. */
+int axidma_oneway_transfer_h(axidma_dev_t dev, int channel, int handle,
+        size_t offset, size_t len, bool wait)
+{
+    int rc;
+    struct axidma_transaction trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = wait;
+    trans.poll = false;
+    trans.channel_id = channel;
+    trans.buf = (void *)offset;
+    trans.buf_len = len;
+    trans.buf_handle = handle;
+    trans.timeout_ms = 0;
     axidma_cmd = dir_to_ioctl(dma_chan->dir);
 
     // Perform the given transfer
@@ -467,6 +1477,461 @@ int axidma_oneway_transfer(axidma_dev_t dev, int channel, void *buf,
     return 0;
 }
 
+/* This creates a pre-prepared transfer template for the given buffer on the
+ * given channel. The driver translates the buffer and builds its descriptor
+ * chain once, up front, so triggering the template skips that work on every
+ * iteration. Returns the template id (positive), or a negative value. */
+int axidma_template_create(axidma_dev_t dev, int channel, void *buf,
+        size_t len)
+{
+    int rc;
+    struct axidma_template tmpl;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Setup the argument structure to the IOCTL
+    tmpl.channel_id = channel;
+    tmpl.buf = buf;
+    tmpl.buf_len = len;
+    tmpl.buf_handle = 0;
+
+    // Create the template with the driver
+    rc = ioctl(dev->fd, AXIDMA_CREATE_TEMPLATE, &tmpl);
+    if (rc < 0) {
+        perror("Failed to create the AXI DMA transfer template");
+        return rc;
+    }
+
+    return tmpl.template_id;
+}
+
+/* This triggers a transfer from a template created with
+ * axidma_template_create. The user determines if this is blocking or not
+ * with `wait`. */
+int axidma_template_trigger(axidma_dev_t dev, int template_id, bool wait)
+{
+    int rc;
+    struct axidma_trigger trigger;
+
+    // Setup the argument structure to the IOCTL
+    trigger.template_id = template_id;
+    trigger.wait = wait;
+    trigger.timeout_ms = 0;
+
+    // Trigger the transfer with the driver
+    rc = ioctl(dev->fd, AXIDMA_DMA_TRIGGER, &trigger);
+    if (rc < 0) {
+        perror("Failed to trigger the AXI DMA transfer template");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This destroys a transfer template, freeing its driver-side resources. */
+int axidma_template_destroy(axidma_dev_t dev, int template_id)
+{
+    int rc;
+
+    rc = ioctl(dev->fd, AXIDMA_DESTROY_TEMPLATE, template_id);
+    if (rc < 0) {
+        perror("Failed to destroy the AXI DMA transfer template");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This performs a blocking one-way transfer over AXI DMA that is completed
+ * by busy-polling the engine from the submitting CPU, rather than sleeping
+ * for an interrupt. This gives the lowest possible round trip for small
+ * transfers on latency-critical channels, at the cost of burning the CPU
+ * for the duration of the transfer. */
+int axidma_oneway_transfer_poll(axidma_dev_t dev, int channel, void *buf,
+        size_t len)
+{
+    int rc;
+    struct axidma_transaction trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = true;
+    trans.poll = true;
+    trans.channel_id = channel;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = 0;
+    axidma_cmd = dir_to_ioctl(dma_chan->dir);
+
+    // Perform the given transfer
+    rc = ioctl(dev->fd, axidma_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to perform the polled AXI DMA transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This performs a one-way transfer over AXI DMA from an arbitrary buffer in
+ * the process's memory, rather than one allocated by axidma_malloc. The
+ * driver pins the buffer's pages for the duration of the transfer, so the
+ * data moves with no staging copy. The user determines if this is blocking or
+ * not with `wait`. */
+int axidma_oneway_transfer_user(axidma_dev_t dev, int channel, void *buf,
+        size_t len, bool wait)
+{
+    int rc;
+    struct axidma_transaction trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = wait;
+    trans.poll = false;
+    trans.channel_id = channel;
+    trans.buf = buf;
+    trans.buf_len = len;
+    trans.buf_handle = 0;
+    trans.timeout_ms = 0;
+    if (dma_chan->dir == AXIDMA_READ) {
+        axidma_cmd = AXIDMA_DMA_READ_USER;
+    } else {
+        axidma_cmd = AXIDMA_DMA_WRITE_USER;
+    }
+
+    // Perform the given transfer
+    rc = ioctl(dev->fd, axidma_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to perform the AXI DMA transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This performs a single bulk transfer striped across several channels. The
+ * buffer is cut into chunks of the given size, the chunks are submitted
+ * round-robin across all of the listed channels so the engines work in
+ * parallel, and the call blocks until the last chunk lands. With independent
+ * channels, the bandwidth scales nearly linearly with their number. The
+ * completions are aggregated through an eventfd registered on each listed
+ * channel for the duration of the call, which replaces any eventfd the user
+ * had registered on them. */
+int axidma_striped_transfer(axidma_dev_t dev, const array_t *channels,
+        void *buf, size_t len, size_t chunk_size)
+{
+    int rc, i, efd, submitted;
+    size_t offset, chunk_len;
+    uint64_t completed, count;
+    ssize_t read_rc;
+    enum axidma_dir dir;
+    dma_channel_t *dma_chan;
+
+    assert(channels != NULL && channels->len > 0);
+    assert(chunk_size > 0);
+
+    // All of the listed channels must exist and share one direction
+    dma_chan = find_channel(dev, channels->data[0]);
+    assert(dma_chan != NULL);
+    dir = dma_chan->dir;
+    for (i = 1; i < channels->len; i++)
+    {
+        dma_chan = find_channel(dev, channels->data[i]);
+        assert(dma_chan != NULL);
+        assert(dma_chan->dir == dir);
+    }
+
+    // Create the eventfd that aggregates completions across the channels
+    efd = eventfd(0, 0);
+    if (efd < 0) {
+        perror("Failed to create the striping eventfd");
+        return -errno;
+    }
+    for (i = 0; i < channels->len; i++)
+    {
+        rc = axidma_set_eventfd(dev, channels->data[i], efd);
+        if (rc < 0) {
+            goto clear_eventfds;
+        }
+    }
+
+    /* Submit the chunks round-robin across the channels, clipping the last
+     * chunk to the end of the buffer. A submission failure stops handing
+     * out new chunks, but the chunks already in flight must still land
+     * before the eventfd can be torn down. */
+    rc = 0;
+    submitted = 0;
+    for (offset = 0; offset < len; offset += chunk_size)
+    {
+        chunk_len = len - offset;
+        if (chunk_len > chunk_size) {
+            chunk_len = chunk_size;
+        }
+        rc = axidma_submit_transfer(dev,
+                channels->data[submitted % channels->len],
+                (char *)buf + offset, chunk_len);
+        if (rc < 0) {
+            break;
+        }
+        rc = 0;
+        submitted += 1;
+    }
+
+    /* Wait for every submitted chunk to land. Each completion adds one to
+     * the eventfd's count, so the reads are accumulated until they cover
+     * all of the submissions. */
+    completed = 0;
+    while (completed < (uint64_t)submitted)
+    {
+        read_rc = read(efd, &count, sizeof(count));
+        if (read_rc < (ssize_t)sizeof(count)) {
+            perror("Failed to read the striping eventfd");
+            rc = -errno;
+            break;
+        }
+        completed += count;
+    }
+
+clear_eventfds:
+    // Unregister the eventfd from the channels, and release it
+    for (i = 0; i < channels->len; i++)
+    {
+        axidma_set_eventfd(dev, channels->data[i], -1);
+    }
+    close(efd);
+    return rc;
+}
+
+/* This configures interrupt coalescing for the given DMA channel, setting
+ * the number of completions the engine accumulates before interrupting, and
+ * the delay timer that flushes a partial batch. */
+int axidma_set_coalescing(axidma_dev_t dev, int channel, int coalesce,
+        int delay)
+{
+    int rc;
+    struct axidma_coalesce coal;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Setup the argument structure to the IOCTL
+    coal.channel_id = channel;
+    coal.coalesce = coalesce;
+    coal.delay = delay;
+
+    // Apply the coalescing settings with the driver
+    rc = ioctl(dev->fd, AXIDMA_SET_COALESCING, &coal);
+    if (rc < 0) {
+        perror("Failed to set the AXI DMA coalescing settings");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This reads the accumulated statistics of the given DMA channel from the
+ * driver. Reading the counters is cheap and does not perturb transfers, so
+ * it is suitable for periodic polling by a monitoring agent. */
+int axidma_get_stats(axidma_dev_t dev, int channel,
+        struct axidma_chan_stats *stats)
+{
+    int rc;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Setup the argument structure to the IOCTL
+    stats->channel_id = channel;
+
+    // Read the channel's counters from the driver
+    rc = ioctl(dev->fd, AXIDMA_GET_CHANNEL_STATS, stats);
+    if (rc < 0) {
+        perror("Failed to get the AXI DMA channel statistics");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This reads the kernel timestamps of the lifecycle stages of the last
+ * transfer completed on the given DMA channel, so a latency spike can be
+ * attributed to the layer it occurred in. */
+int axidma_get_transfer_times(axidma_dev_t dev, int channel,
+        struct axidma_transfer_times *times)
+{
+    int rc;
+
+    assert(find_channel(dev, channel) != NULL);
+
+    // Setup the argument structure to the IOCTL
+    times->channel_id = channel;
+
+    // Read the last transfer's stage timestamps from the driver
+    rc = ioctl(dev->fd, AXIDMA_GET_TRANSFER_TIMES, times);
+    if (rc < 0) {
+        perror("Failed to get the AXI DMA transfer times");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This starts a cyclic streaming transfer on the given DMA channel, cutting
+ * the buffer into num_periods ring slots that the engine fills (or drains)
+ * continuously with no gap in between. Filled slots are consumed with
+ * axidma_stream_next, and the stream runs until axidma_stream_stop. */
+int axidma_stream_start(axidma_dev_t dev, int channel, void *buf, size_t len,
+        int num_periods)
+{
+    int rc;
+    struct axidma_stream stream;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+    assert(num_periods > 1 && len % num_periods == 0);
+
+    // Setup the argument structure to the IOCTL
+    stream.channel_id = channel;
+    stream.buf = buf;
+    stream.buf_len = len;
+    stream.num_periods = num_periods;
+
+    // Start the stream with the driver
+    rc = ioctl(dev->fd, AXIDMA_STREAM_START, &stream);
+    if (rc < 0) {
+        perror("Failed to start the AXI DMA stream");
+        return rc;
+    }
+
+    // Record the ring geometry, so slot indices can be turned into pointers
+    dma_chan->stream_buf = buf;
+    dma_chan->stream_period_len = len / num_periods;
+    return 0;
+}
+
+/* This consumes the next filled slot of a cyclic stream, returning a pointer
+ * to the slot's data within the stream's ring buffer. If `wait` is false and
+ * no slot is ready, NULL is returned. If the consumer has fallen a full ring
+ * behind the engine, the overwritten slots are skipped, and their count is
+ * reported through `dropped` if it is non-NULL. */
+void *axidma_stream_next(axidma_dev_t dev, int channel, bool wait,
+        unsigned long *dropped)
+{
+    int rc;
+    struct axidma_stream_slot slot;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+    assert(dma_chan->stream_buf != NULL);
+
+    // Setup the argument structure to the IOCTL
+    slot.channel_id = channel;
+    slot.wait = wait;
+
+    // Consume the next filled slot from the driver
+    rc = ioctl(dev->fd, AXIDMA_STREAM_NEXT, &slot);
+    if (rc < 0) {
+        perror("Failed to get the next AXI DMA stream slot");
+        return NULL;
+    }
+
+    if (dropped != NULL) {
+        *dropped = slot.dropped;
+    }
+    if (slot.slot < 0) {
+        return NULL;
+    }
+
+    return (char *)dma_chan->stream_buf +
+           slot.slot * dma_chan->stream_period_len;
+}
+
+/* This stops the cyclic stream running on the given DMA channel. */
+int axidma_stream_stop(axidma_dev_t dev, int channel)
+{
+    int rc;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Stop the stream with the driver
+    rc = ioctl(dev->fd, AXIDMA_STREAM_STOP, channel);
+    if (rc < 0) {
+        perror("Failed to stop the AXI DMA stream");
+        return rc;
+    }
+
+    dma_chan->stream_buf = NULL;
+    dma_chan->stream_period_len = 0;
+    return 0;
+}
+
+/* This submits a batch of transfers to the AXI DMA engine in one system call,
+ * issuing each involved channel only once. The user determines if this call
+ * blocks until the whole batch has completed with `wait`. */
+int axidma_batch_transfer(axidma_dev_t dev, struct axidma_transaction *trans,
+        int num_trans, bool wait)
+{
+    int rc;
+    struct axidma_batch_transaction batch;
+
+    // Setup the argument structure to the IOCTL
+    batch.wait = wait;
+    batch.num_trans = num_trans;
+    batch.trans = trans;
+
+    // Perform the batch submission
+    rc = ioctl(dev->fd, AXIDMA_DMA_SUBMIT_BATCH, &batch);
+    if (rc < 0) {
+        perror("Failed to perform the AXI DMA batch transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
+/* This performs a vectored one-way transfer over AXI DMA, gathering or
+ * scattering the data across the given array of buffer segments. The user
+ * determines if this is blocking or not with `wait`. */
+int axidma_oneway_transfer_v(axidma_dev_t dev, int channel,
+        const struct axidma_iovec *iov, int icount, bool wait)
+{
+    int rc;
+    struct axidma_transaction_vec trans;
+    unsigned long axidma_cmd;
+    dma_channel_t *dma_chan;
+
+    dma_chan = find_channel(dev, channel);
+    assert(dma_chan != NULL);
+
+    // Setup the argument structure to the IOCTL
+    trans.wait = wait;
+    trans.channel_id = channel;
+    trans.icount = icount;
+    trans.iov = (struct axidma_iovec *)iov;
+    axidma_cmd = (dma_chan->dir == AXIDMA_READ) ? AXIDMA_DMA_READV :
+                                                  AXIDMA_DMA_WRITEV;
+
+    // Perform the given transfer
+    rc = ioctl(dev->fd, axidma_cmd, &trans);
+    if (rc < 0) {
+        perror("Failed to perform the AXI DMA vectored transfer");
+        return rc;
+    }
+
+    return 0;
+}
+
 /* This performs a two-way transfer over AXI DMA, both sending data out and
  * receiving it back over DMA. The user determines if this call is blocking. */
 int axidma_twoway_transfer(axidma_dev_t dev, int tx_channel, void *tx_buf,
@@ -546,6 +2011,33 @@ int axidma_video_transfer(axidma_dev_t dev, int display_channel, size_t width,
     return rc;
 }
 
+/* This switches the frame buffer a running video transfer scans out, parking
+ * the VDMA engine on the frame with the given index. The switch happens at
+ * the next frame boundary, so it is tear-free and the display is never
+ * blanked, unlike a stop/start of the transfer. A negative index resumes
+ * circulating through all of the transfer's frame buffers. */
+int axidma_video_set_frame(axidma_dev_t dev, int display_channel,
+        int frame_index)
+{
+    int rc;
+    struct axidma_frame_sel frame_sel;
+
+    assert(find_channel(dev, display_channel) != NULL);
+    assert(find_channel(dev, display_channel)->type == AXIDMA_VDMA);
+
+    // Setup the argument structure for the IOCTL
+    frame_sel.channel_id = display_channel;
+    frame_sel.frame_index = frame_index;
+
+    // Perform the frame switch with the driver
+    rc = ioctl(dev->fd, AXIDMA_VIDEO_SET_FRAME, &frame_sel);
+    if (rc < 0) {
+        perror("Failed to switch the video transfer's frame");
+    }
+
+    return rc;
+}
+
 /* This function stops all transfers on the given channel with the given
  * direction. This function is required to stop any video transfers, or any
  * non-blocking transfers. */
@@ -14,8 +14,9 @@ LIBAXIDMA_MAKEFILE_=included
 # Configuration
 ################################################################################
 
-# The flags for compiling the library
-LIBAXIDMA_CFLAGS = $(GLOBAL_CFLAGS) -fPIC -shared \
+# The flags for compiling the library. The callback dispatcher runs on a
+# dedicated thread, so the library needs the pthread support.
+LIBAXIDMA_CFLAGS = $(GLOBAL_CFLAGS) -fPIC -shared -pthread \
 				   -Wno-missing-field-initializers
 
 # The files that makeup the AXI DMA library